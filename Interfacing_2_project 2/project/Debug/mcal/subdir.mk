@@ -4,16 +4,34 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../mcal/adc.c \
+../mcal/eeprom.c \
 ../mcal/gpio.c \
-../mcal/icu.c 
+../mcal/icu.c \
+../mcal/timer0.c \
+../mcal/timer2.c \
+../mcal/uart.c \
+../mcal/wdt.c 
 
 OBJS += \
+./mcal/adc.o \
+./mcal/eeprom.o \
 ./mcal/gpio.o \
-./mcal/icu.o 
+./mcal/icu.o \
+./mcal/timer0.o \
+./mcal/timer2.o \
+./mcal/uart.o \
+./mcal/wdt.o 
 
 C_DEPS += \
+./mcal/adc.d \
+./mcal/eeprom.d \
 ./mcal/gpio.d \
-./mcal/icu.d 
+./mcal/icu.d \
+./mcal/timer0.d \
+./mcal/timer2.d \
+./mcal/uart.d \
+./mcal/wdt.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -22,4 +22,5 @@ SUBDIRS := \
 app \
 hal \
 mcal \
+service \
 
@@ -0,0 +1,45 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../service/calibration.c \
+../service/filter.c \
+../service/health.c \
+../service/power.c \
+../service/probe.c \
+../service/scheduler.c \
+../service/settings.c \
+../service/telemetry.c 
+
+OBJS += \
+./service/calibration.o \
+./service/filter.o \
+./service/health.o \
+./service/power.o \
+./service/probe.o \
+./service/scheduler.o \
+./service/settings.o \
+./service/telemetry.o 
+
+C_DEPS += \
+./service/calibration.d \
+./service/filter.d \
+./service/health.d \
+./service/power.d \
+./service/probe.d \
+./service/scheduler.d \
+./service/settings.d \
+./service/telemetry.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+service/%.o: ../service/%.c service/subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -Os -flto -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=16000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -1,287 +1,937 @@
-#include "../hal/ultrasonic.h"
-#include "../hal/lcd.h"
-#include "../hal/led.h"
-#include "../hal/buzzer.h"
-#include <util/delay.h>
-
-#define DISTANCE_DANGER 5               /**< @brief Distance threshold for danger state in cm */
-#define DISTANCE_WARNING_MAX 10         /**< @brief Maximum distance for warning state in cm */
-#define DISTANCE_SAFE_MAX 15            /**< @brief Maximum distance for safe state in cm */
-#define DISTANCE_DETECTED_MAX 20        /**< @brief Maximum distance for detected state in cm */
-
-/**
- * @brief Displays the normal distance reading on the LCD.
- *
- * This function moves the cursor to the start of the LCD,
- * then displays the current distance measured by the ultrasonic sensor
- * along with the unit 'cm'.
- */
-void LCD_dispDataNorm(void);
-
-/**
- * @brief Displays a "STOP" danger message on the LCD.
- *
- * This function moves the cursor to the start of the LCD,
- * then displays a "STOP" message to warn the user of immediate danger.
- */
-void LCD_dispDataDanger(void);
-
-/**
- * @brief Handles the system behavior when in the danger state.
- *
- * In the danger state, the buzzer is activated, and all LEDs blink.
- * The blinking effect is achieved by alternating the LEDs on and off with delays.
- */
-void handleDangerState(void);
-
-/**
- * @brief Handles the system behavior when in the warning state.
- *
- * In the warning state, the distance is displayed on the LCD, and all LEDs are turned on.
- * The buzzer remains off.
- */
-void handleWarningState(void);
-
-/**
- * @brief Handles the system behavior when in the safe state.
- *
- * In the safe state, the distance is displayed on the LCD. The red and green LEDs are turned on,
- * while the blue LED remains off. The buzzer is not activated.
- */
-void handleSafeState(void);
-
-/**
- * @brief Handles the system behavior when in the detected state.
- *
- * In the detected state, the distance is displayed on the LCD, and only the red LED is turned on.
- * The green and blue LEDs are turned off, and the buzzer is off.
- */
-void handleDetectedState(void);
-
-/**
- * @brief Handles the system behavior when in the idle state.
- *
- * In the idle state, the distance is displayed on the LCD, and all LEDs and the buzzer are turned off.
- */
-void handleIdleState(void);
-
-/**
- * @brief State machine handler function.
- *
- * This function determines the current system state based on the measured distance and calls
- * the corresponding handler function for each state. The state transitions are as follows:
- * - DANGER: distance <= DISTANCE_DANGER
- * - WARNING: distance between DISTANCE_DANGER+1 and DISTANCE_WARNING_MAX
- * - SAFE: distance between DISTANCE_WARNING_MAX+1 and DISTANCE_SAFE_MAX
- * - DETECTED: distance between DISTANCE_SAFE_MAX+1 and DISTANCE_DETECTED_MAX
- * - IDLE: distance > DISTANCE_DETECTED_MAX
- */
-void StateMachineHandler(void);
-
-/**
- * @enum STATE_MACHINE
- * @brief Enum defining the different states of the system based on distance.
- *
- * The states are:
- * - IDLE: No object detected (distance > 20 cm)
- * - DETECTED: Object detected between 16 cm and 20 cm
- * - SAFE: Object detected between 11 cm and 15 cm
- * - WARNING: Object detected between 6 cm and 10 cm
- * - DANGER: Object detected at a dangerously close distance (≤ 5 cm)
- */
-typedef enum {
-    IDLE,       /**< No object detected (distance > 20 cm) */
-    DETECTED,   /**< Object detected between 16 cm and 20 cm */
-    SAFE,       /**< Object detected between 11 cm and 15 cm */
-    WARNING,    /**< Object detected between 6 cm and 10 cm */
-    DANGER      /**< Object detected at a dangerously close distance (≤ 5 cm) */
-} STATE_MACHINE;
-
-/**
- * @var g_distance
- * @brief Global variable to store the current distance measured by the ultrasonic sensor.
- *
- * This value is updated continuously in the main loop and used by the state machine handler
- * to determine the current system state.
- */
-uint16 g_distance = 0;
-
-/**
- * @var g_stateMachine
- * @brief Global variable to store the current state of the state machine.
- *
- * The state machine is updated based on the measured distance, and this variable holds
- * the current state (IDLE, DETECTED, SAFE, WARNING, or DANGER).
- */
-STATE_MACHINE g_stateMachine = IDLE;
-
-/**
- * @brief Main application entry point.
- *
- * Initializes all hardware components and continuously monitors the distance
- * to manage the state machine.
- *
- * @return This function does not return a value.
- */
-int main(void) {
-    /* Initialize hardware components */
-    LED_init();            /**< Initialize the LED module */
-    Ultrasonic_init();     /**< Initialize the ultrasonic sensor */
-    LCD_init();            /**< Initialize the LCD display */
-    Buzzer_init();         /**< Initialize the buzzer */
-
-    /* Ensure the buzzer and LEDs are off initially */
-    Buzzer_off();          /**< Turn off the buzzer */
-    LED_off(LED_RED_3);    /**< Turn off the red LED */
-    LED_off(LED_GREEN_2);  /**< Turn off the green LED */
-    LED_off(LED_BLUE_1);   /**< Turn off the blue LED */
-
-    /* Main loop to continuously read distance and update the state machine */
-    for (;;) {
-        /* Read the current distance from the ultrasonic sensor */
-        g_distance = Ultrasonic_readDistance();
-
-        /* Handle the state machine logic based on the distance */
-        StateMachineHandler();
-    }
-}
-
-/**
- * @brief State machine handler.
- *
- * This function determines the current state based on the measured distance and invokes
- * the corresponding handler function based on the determined state.
- */
-void StateMachineHandler(void) {
-    /* Determine the state based on the distance */
-    if (g_distance <= DISTANCE_DANGER) {
-        g_stateMachine = DANGER; /**< Set state to DANGER if distance is ≤ 5 cm */
-    } else if (g_distance <= DISTANCE_WARNING_MAX) {
-        g_stateMachine = WARNING; /**< Set state to WARNING if distance is between 6 cm and 10 cm */
-    } else if (g_distance <= DISTANCE_SAFE_MAX) {
-        g_stateMachine = SAFE; /**< Set state to SAFE if distance is between 11 cm and 15 cm */
-    } else if (g_distance <= DISTANCE_DETECTED_MAX) {
-        g_stateMachine = DETECTED; /**< Set state to DETECTED if distance is between 16 cm and 20 cm */
-    } else {
-        g_stateMachine = IDLE; /**< Set state to IDLE if distance is greater than 20 cm */
-    }
-
-    /* Invoke the appropriate handler function based on the current state */
-    switch (g_stateMachine) {
-        case DANGER:
-            handleDangerState(); /**< Handle danger state */
-            break;
-        case WARNING:
-            handleWarningState(); /**< Handle warning state */
-            break;
-        case SAFE:
-            handleSafeState(); /**< Handle safe state */
-            break;
-        case DETECTED:
-            handleDetectedState(); /**< Handle detected state */
-            break;
-        case IDLE:
-            handleIdleState(); /**< Handle idle state */
-            break;
-    }
-}
-
-/**
- * @brief Handles the danger state.
- *
- * In the danger state, the buzzer is activated, and all LEDs blink in a pattern.
- * The blinking effect is achieved by alternating the LEDs on and off with delays.
- */
-void handleDangerState(void) {
-    LCD_dispDataDanger(); /**< Display danger message on the LCD */
-    Buzzer_on();          /**< Turn on the buzzer */
-    LED_on(LED_RED_3);    /**< Turn on the red LED */
-    LED_on(LED_GREEN_2);  /**< Turn on the green LED */
-    LED_on(LED_BLUE_1);   /**< Turn on the blue LED */
-    _delay_ms(200);       /**< Delay to create a blinking effect */
-    Buzzer_off();         /**< Turn off the buzzer */
-    LED_off(LED_RED_3);   /**< Turn off the red LED */
-    LED_off(LED_GREEN_2); /**< Turn off the green LED */
-    LED_off(LED_BLUE_1);  /**< Turn off the blue LED */
-    _delay_ms(200);       /**< Delay to create a blinking effect */
-}
-
-/**
- * @brief Handles the warning state.
- *
- * In the warning state, the distance is displayed on the LCD, and all LEDs are turned on.
- * The buzzer remains off.
- */
-void handleWarningState(void) {
-    LCD_dispDataNorm();   /**< Display normal distance on the LCD */
-    Buzzer_off();         /**< Ensure the buzzer is off */
-    LED_on(LED_RED_3);    /**< Turn on the red LED */
-    LED_on(LED_GREEN_2);  /**< Turn on the green LED */
-    LED_on(LED_BLUE_1);   /**< Turn on the blue LED */
-}
-
-/**
- * @brief Handles the safe state.
- *
- * In the safe state, the distance is displayed on the LCD. The red and green LEDs are turned on,
- * while the blue LED remains off. The buzzer is not activated.
- */
-void handleSafeState(void) {
-    LCD_dispDataNorm();   /**< Display normal distance on the LCD */
-    Buzzer_off();         /**< Ensure the buzzer is off */
-    LED_on(LED_RED_3);    /**< Turn on the red LED */
-    LED_on(LED_GREEN_2);  /**< Turn on the green LED */
-    LED_off(LED_BLUE_1);  /**< Turn off the blue LED */
-}
-
-/**
- * @brief Handles the detected state.
- *
- * In the detected state, the distance is displayed on the LCD, and only the red LED is turned on.
- * The green and blue LEDs are turned off, and the buzzer is off.
- */
-void handleDetectedState(void) {
-    LCD_dispDataNorm();   /**< Display normal distance on the LCD */
-    Buzzer_off();         /**< Ensure the buzzer is off */
-    LED_on(LED_RED_3);    /**< Turn on the red LED */
-    LED_off(LED_GREEN_2); /**< Turn off the green LED */
-    LED_off(LED_BLUE_1);  /**< Turn off the blue LED */
-}
-
-/**
- * @brief Handles the idle state.
- *
- * In the idle state, the distance is displayed on the LCD, and all LEDs and the buzzer are turned off.
- */
-void handleIdleState(void) {
-    LCD_dispDataNorm();   /**< Display normal distance on the LCD */
-    Buzzer_off();         /**< Ensure the buzzer is off */
-    LED_off(LED_RED_3);   /**< Turn off the red LED */
-    LED_off(LED_GREEN_2); /**< Turn off the green LED */
-    LED_off(LED_BLUE_1);  /**< Turn off the blue LED */
-}
-
-/**
- * @brief Displays the normal distance reading on the LCD.
- *
- * This function moves the cursor to the start of the LCD,
- * then displays the current distance measured by the ultrasonic sensor
- * along with the unit 'cm'.
- */
-void LCD_dispDataNorm(void) {
-    LCD_moveCursor(0, 0);                  /**< Move the cursor to the start */
-    LCD_displayString("Distance= ");       /**< Display label for distance */
-    LCD_intgerToString(g_distance);        /**< Display the current distance */
-    LCD_displayString("cm");               /**< Display the unit 'cm' */
-}
-
-/**
- * @brief Displays a "STOP" danger message on the LCD.
- *
- * This function moves the cursor to the start of the LCD,
- * then displays a "STOP" message to warn the user of immediate danger.
- */
-void LCD_dispDataDanger(void) {
-    LCD_moveCursor(0, 0);                  /**< Move the cursor to the start */
-    LCD_displayString("      STOP      "); /**< Display the "STOP" message */
-}
+#include "../hal/ultrasonic.h"
+#include "../hal/lcd.h"
+#include "../hal/led.h"
+#include "../hal/buzzer.h"
+#include "../service/scheduler.h"
+#include "../service/filter.h"
+#include "../service/power.h"
+#include "../service/probe.h"
+#include "../service/telemetry.h"
+#include "../service/calibration.h"
+#include "../service/settings.h"
+#include "../service/health.h"
+#include <avr/pgmspace.h>
+
+/* Default thresholds, used until thresholds are stored in the EEPROM for the installation */
+#define DISTANCE_DANGER 50              /**< @brief Distance threshold for danger state in mm (5 cm) */
+#define DISTANCE_WARNING_MAX 100        /**< @brief Maximum distance for warning state in mm (10 cm) */
+#define DISTANCE_SAFE_MAX 150           /**< @brief Maximum distance for safe state in mm (15 cm) */
+#define DISTANCE_DETECTED_MAX 200       /**< @brief Maximum distance for detected state in mm (20 cm) */
+#define DISTANCE_HYSTERESIS 10          /**< @brief Extra distance in mm needed to leave a state once entered */
+
+#define APP_THRESHOLDS_MAGIC 0x7401     /**< @brief Magic number and layout version of the thresholds settings record */
+#define APP_THRESHOLDS_WIRE_SIZE 10     /**< @brief Thresholds in a command frame: danger, warning, safe, detected, hysteresis (2 each) */
+#define APP_CALIBRATION_WIRE_SIZE 5     /**< @brief Calibration in a command frame: offset (2), gain (2), flags (1) */
+#define APP_COMMAND_SET_THRESHOLDS 0x01 /**< @brief Command storing new thresholds, answered with a status */
+#define APP_COMMAND_GET_THRESHOLDS 0x02 /**< @brief Command reading the thresholds, answered with a status and the thresholds */
+#define APP_COMMAND_GET_STARTUP 0x03    /**< @brief Command reading the startup times, answered with a status and the times */
+#define APP_COMMAND_SET_CALIBRATION 0x04 /**< @brief Command storing the calibration of the unit, answered with a status */
+#define APP_COMMAND_GET_CALIBRATION 0x05 /**< @brief Command reading the calibration, answered with a status, the calibration and the temperature */
+#define APP_STATUS_OK 0x00              /**< @brief Reply status: the command was applied */
+#define APP_STATUS_REJECTED 0x01        /**< @brief Reply status: unknown command, wrong length, inconsistent thresholds or calibration */
+
+#define APP_LED_ALL (LED_MASK(LED_BLUE_1) | LED_MASK(LED_GREEN_2) | LED_MASK(LED_RED_3)) /**< @brief Mask of all the LEDs */
+#define APP_OUTPUT_BLINK 0x01           /**< @brief The LEDs of the mask blink with APP_BLINK_PERIOD_MS */
+#define APP_OUTPUT_BEEP 0x02            /**< @brief The buzzer plays the danger pattern */
+#define APP_OUTPUT_STOP 0x04            /**< @brief The LCD shows the "STOP" message instead of the distance */
+#define APP_OUTPUT_CADENCE 0x08         /**< @brief The buzzer beeps faster as the distance gets shorter */
+#define APP_OUTPUT_FAULT 0x10           /**< @brief The LCD shows the fault message and the buzzer plays the fault pattern */
+
+#define APP_SENSE_PERIOD_MS 60          /**< @brief State machine period, one HC-SR04 measurement cycle */
+#define APP_SENSE_OFFSET_MS 5           /**< @brief First sensing run, after the echo of a first ping triggered on ticks 1-2 from within 40 cm */
+#define APP_DISPLAY_PERIOD_MS 100       /**< @brief LCD refresh period */
+#define APP_TELEMETRY_PERIOD_MS 100     /**< @brief Period of the telemetry frames, 27 bytes each at 57600 baud */
+#define APP_CALIBRATION_PERIOD_MS 1000  /**< @brief Period of the thermistor readings of the temperature compensation */
+#define APP_SETTINGS_PERIOD_MS 10       /**< @brief Period of the EEPROM store steps, one byte of about 8.5 ms per run */
+#define APP_SETTINGS_OFFSET_MS 3        /**< @brief First store step, on ticks no other task is released on */
+#define APP_BLINK_PERIOD_MS 400         /**< @brief Period of the LED blinking in the danger state */
+#define APP_IDLE_PING_SHORT_MS 150      /**< @brief Slowest ping interval of the first APP_IDLE_DWELL_MS in IDLE, an obstacle that just left often comes back */
+#define APP_IDLE_PING_MAX_MS 500        /**< @brief Slowest ping interval reached while nothing is in range for longer */
+#define APP_IDLE_DWELL_MS 10000UL       /**< @brief Time in IDLE without a reading in range before the interval grows past APP_IDLE_PING_SHORT_MS */
+#define APP_RANGE_PING_MAX_MS 500       /**< @brief Slowest ping interval of a static obstacle in range */
+#define APP_PING_MS_PER_MM 1            /**< @brief Ping interval per mm of distance for a static obstacle */
+#define APP_PINGS_BEFORE_DANGER 8       /**< @brief Samples wanted before an approaching obstacle reaches the danger threshold */
+#define APP_SPEED_SHIFT 1               /**< @brief Smoothing of the closing speed, each estimate moves 1/2^shift of the way */
+#define APP_BEEP_ON_UNITS 5             /**< @brief Length of a distance-scaled beep in BUZZER_UNIT_MS units */
+#define APP_DISTANCE_DIGITS 3           /**< @brief Cells of the distance in cm on the LCD, dashes beyond 999 cm (no echo) */
+#define APP_BAR_STEPS (LCD_COLUMNS * LCD_BAR_STEPS_PER_CELL) /**< @brief Steps of the proximity bar over the whole row */
+
+/* Startup budget from Scheduler_init(), the first step of main(), checked by the simulation build.
+ * The fuse selected start-up time of the oscillator (up to 65 ms) comes before it. */
+#define APP_STARTUP_SAMPLE_BUDGET_MS 10 /**< @brief First distance sample read by the sensing task */
+#define APP_STARTUP_FRAME_BUDGET_MS 100 /**< @brief First frame shown by the LCD, after its 20 ms power-up and init sequence */
+#define APP_STARTUP_ALERT_BUDGET_MS 10  /**< @brief Danger alert with an obstacle within the danger distance at power-up */
+
+/**
+ * @struct APP_ThresholdsType
+ * @brief Distance thresholds of the installation in mm, the record stored in the EEPROM.
+ */
+typedef struct {
+    uint16 dangerMm;      /**< Largest distance of the DANGER state. */
+    uint16 warningMaxMm;  /**< Largest distance of the WARNING state. */
+    uint16 safeMaxMm;     /**< Largest distance of the SAFE state. */
+    uint16 detectedMaxMm; /**< Largest distance of the DETECTED state, farther is IDLE. */
+    uint16 hysteresisMm;  /**< Extra distance needed to leave a state once entered. */
+} APP_ThresholdsType;
+
+/**
+ * @enum APP_StartupEventType
+ * @brief Startup milestones timed in scheduler ticks from Scheduler_init(), indexes of g_startupTimes.
+ */
+typedef enum {
+    APP_STARTUP_FIRST_SAMPLE, /**< First measurement read by the sensing task, an echo or a timeout. */
+    APP_STARTUP_FIRST_FRAME,  /**< First framebuffer completely shown by the LCD. */
+    APP_STARTUP_FIRST_ALERT,  /**< First danger alert. */
+    APP_STARTUP_EVENTS        /**< Number of milestones. */
+} APP_StartupEventType;
+
+/**
+ * @brief Sensing task.
+ *
+ * Filters the new readings of the sensor array, takes the nearest filtered obstacle and runs
+ * the state machine.
+ */
+void APP_senseTask(void);
+
+/**
+ * @brief Display refresh task.
+ *
+ * Shows the "STOP" message in the danger state, the fault message in the fault state and the
+ * distance otherwise.
+ */
+void APP_displayTask(void);
+
+/**
+ * @brief Telemetry task.
+ *
+ * Serves the received commands, then sends a telemetry frame with the current sample, dropped if
+ * the UART is still busy.
+ */
+void APP_telemetryTask(void);
+
+/**
+ * @brief Checks thresholds and makes them the ones in use, precomputing the band of every state.
+ *
+ * @param a_thresholds The thresholds.
+ * @return FALSE, keeping the thresholds in use, unless they increase from danger to detected and
+ *         the detected band with its hysteresis stays below ULTRASONIC_NO_ECHO_DISTANCE.
+ */
+boolean APP_setThresholds(const APP_ThresholdsType *a_thresholds);
+
+/**
+ * @brief Loads the thresholds of the installation from the EEPROM, or the defaults.
+ */
+void APP_loadThresholds(void);
+
+/**
+ * @brief Gets the danger threshold in use, for the alert latency benchmark of the simulation.
+ *
+ * @return The largest distance of the DANGER state in mm.
+ */
+uint16 APP_getDangerMm(void);
+
+/**
+ * @brief Handles a command frame received over the telemetry link and sends its reply.
+ *
+ * @param a_payload The payload, the command byte first.
+ * @param a_length Length of the payload.
+ */
+void APP_commandHandler(const uint8 *a_payload, uint8 a_length);
+
+/**
+ * @brief Records the scheduler tick of a startup milestone the first time it is reached.
+ *
+ * @param a_event The milestone (APP_StartupEventType).
+ */
+void APP_recordStartup(uint8 a_event);
+
+/**
+ * @brief Records the first LCD frame once the LCD has shown a completely flushed framebuffer.
+ */
+void APP_watchStartup(void);
+
+/**
+ * @brief Displays the normal distance reading on the LCD.
+ *
+ * This function writes the current distance measured by the ultrasonic sensor
+ * along with the unit 'cm' into the first row of the LCD framebuffer.
+ * Only the characters that changed are sent by the next LCD_flush().
+ */
+void LCD_dispDataNorm(void);
+
+/**
+ * @brief Displays a "STOP" danger message on the LCD.
+ *
+ * This function writes a "STOP" message into the first row of the LCD framebuffer
+ * to warn the user of immediate danger.
+ */
+void LCD_dispDataDanger(void);
+
+/**
+ * @brief Displays a "SENSOR FAULT" message on the LCD.
+ *
+ * This function writes a "SENSOR FAULT" message into the first row of the LCD framebuffer
+ * while the readings of a sensor cannot be trusted.
+ */
+void LCD_dispDataFault(void);
+
+/**
+ * @brief Applies the outputs of a state from the output table, called once on every transition.
+ *
+ * @param a_state The state just entered.
+ */
+void APP_applyOutputs(uint8 a_state);
+
+/**
+ * @brief Scales the beep cadence of the buzzer with the current distance.
+ */
+void APP_updateCadence(void);
+
+/**
+ * @brief Updates the closing speed estimate from the new nearest distance.
+ */
+void APP_updateClosingSpeed(void);
+
+/**
+ * @brief Adapts the ping interval of the sensors to the state, the distance and the closing speed.
+ *
+ * @param a_near TRUE if a raw reading of this run was within the detected threshold.
+ */
+void APP_updatePingRate(boolean a_near);
+
+/**
+ * @brief State machine handler function.
+ *
+ * This function determines the current system state based on the measured distance and applies
+ * the outputs of the new state when it changed. A state is entered at or below the enter threshold
+ * of its band and left only above the exit threshold, the hysteresis further away:
+ * - DANGER: distance <= danger threshold
+ * - WARNING: distance between danger threshold+1 and warning threshold
+ * - SAFE: distance between warning threshold+1 and safe threshold
+ * - DETECTED: distance between safe threshold+1 and detected threshold
+ * - IDLE: distance > detected threshold
+ * - FAULT: a sensor is declared faulty by the health monitor, whatever the distance
+ */
+void StateMachineHandler(void);
+
+/**
+ * @enum STATE_MACHINE
+ * @brief Enum defining the different states of the system based on distance.
+ *
+ * The states are:
+ * - IDLE: No object detected (distance > 20 cm)
+ * - DETECTED: Object detected between 16 cm and 20 cm
+ * - SAFE: Object detected between 11 cm and 15 cm
+ * - WARNING: Object detected between 6 cm and 10 cm
+ * - DANGER: Object detected at a dangerously close distance (≤ 5 cm)
+ * - FAULT: A sensor keeps failing, its readings are not trusted
+ */
+typedef enum {
+    IDLE,       /**< No object detected (distance > 20 cm) */
+    DETECTED,   /**< Object detected between 16 cm and 20 cm */
+    SAFE,       /**< Object detected between 11 cm and 15 cm */
+    WARNING,    /**< Object detected between 6 cm and 10 cm */
+    DANGER,     /**< Object detected at a dangerously close distance (≤ 5 cm) */
+    FAULT       /**< A sensor keeps failing, its readings are not trusted */
+} STATE_MACHINE;
+
+/**
+ * @struct APP_BandType
+ * @brief Distance band of a state, entered at or below `enterMax` and left above `exitMax`.
+ */
+typedef struct {
+    uint16 enterMax; /**< Largest distance in mm entering the state from a farther one. */
+    uint16 exitMax;  /**< Largest distance in mm keeping the state once entered. */
+} APP_BandType;
+
+/**
+ * @struct APP_OutputType
+ * @brief Outputs of a state, applied once when the state is entered.
+ */
+typedef struct {
+    uint8 ledMask;     /**< LEDs turned on, see LED_MASK(). */
+    uint8 ledDuty;     /**< Brightness of the LEDs turned on in percent. */
+    uint8 flags;       /**< APP_OUTPUT_BLINK, APP_OUTPUT_BEEP, APP_OUTPUT_CADENCE, APP_OUTPUT_STOP and APP_OUTPUT_FAULT. */
+} APP_OutputType;
+
+/**
+ * @var g_defaultThresholds
+ * @brief Thresholds used while the EEPROM holds none, stored in flash memory.
+ */
+static const APP_ThresholdsType g_defaultThresholds PROGMEM = {
+    DISTANCE_DANGER, DISTANCE_WARNING_MAX, DISTANCE_SAFE_MAX, DISTANCE_DETECTED_MAX, DISTANCE_HYSTERESIS
+};
+
+/**
+ * @var g_thresholds
+ * @brief Thresholds in use, loaded from the EEPROM at startup or set by a command.
+ */
+static APP_ThresholdsType g_thresholds;
+
+/**
+ * @var g_bands
+ * @brief Distance band of every state indexed by STATE_MACHINE, precomputed from g_thresholds.
+ *
+ * IDLE has no band, it is the state left when no band holds. FAULT has none either, it does not
+ * depend on the distance.
+ */
+static APP_BandType g_bands[DANGER + 1];
+
+/**
+ * @var g_stateOutputs
+ * @brief Outputs of every state indexed by STATE_MACHINE, stored in flash memory.
+ *
+ * The LEDs get brighter as well as more numerous as the obstacle gets closer.
+ */
+static const APP_OutputType g_stateOutputs[] PROGMEM = {
+    { 0, 0, 0 },                                                               /* IDLE: all off */
+    { LED_MASK(LED_RED_3), 30, 0 },                                            /* DETECTED: red, dim */
+    { LED_MASK(LED_RED_3) | LED_MASK(LED_GREEN_2), 60, 0 },                    /* SAFE: red and green */
+    { APP_LED_ALL, 100, APP_OUTPUT_CADENCE },                                  /* WARNING: all on, beeping */
+    { APP_LED_ALL, 100, APP_OUTPUT_BLINK | APP_OUTPUT_BEEP | APP_OUTPUT_STOP }, /* DANGER: all blinking, beeping */
+    { LED_MASK(LED_BLUE_1), 100, APP_OUTPUT_BLINK | APP_OUTPUT_FAULT }         /* FAULT: blue blinking, chirping */
+};
+
+/**
+ * @var g_distance
+ * @brief Global variable to store the nearest distance measured by the ultrasonic sensors in mm.
+ *
+ * This value is updated by APP_senseTask() from the filtered readings of the array and used by the state
+ * machine handler to determine the current system state. A single glitch is removed by the median
+ * filter, a lasting loss of echo reads as nothing in range.
+ */
+uint16 g_distance = 0;
+
+/**
+ * @var g_filters
+ * @brief Median and moving average state of every sensor of the array.
+ */
+static Filter_StateType g_filters[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @var g_filtered
+ * @brief Latest filtered distance of every sensor in mm.
+ */
+static uint16 g_filtered[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @var g_stateMachine
+ * @brief Global variable to store the current state of the state machine.
+ *
+ * The state machine is updated based on the measured distance, and this variable holds
+ * the current state (IDLE, DETECTED, SAFE, WARNING, DANGER or FAULT).
+ */
+STATE_MACHINE g_stateMachine = IDLE;
+
+/**
+ * @var g_startupTimes
+ * @brief Scheduler tick of every startup milestone indexed by APP_StartupEventType, 0 until reached.
+ *
+ * No milestone can be reached on tick 0, the first ping goes out on tick 1.
+ */
+uint32 g_startupTimes[APP_STARTUP_EVENTS];
+
+/**
+ * @var g_startupBudgets
+ * @brief Budget of every startup milestone in ms indexed by APP_StartupEventType, stored in flash memory.
+ */
+const uint16 g_startupBudgets[APP_STARTUP_EVENTS] PROGMEM = {
+    APP_STARTUP_SAMPLE_BUDGET_MS, APP_STARTUP_FRAME_BUDGET_MS, APP_STARTUP_ALERT_BUDGET_MS
+};
+
+/**
+ * @var g_frameFlushed
+ * @brief Set once a flush left no cell dirty, the first frame is shown when the LCD is ready again.
+ */
+static boolean g_frameFlushed = FALSE;
+
+#ifdef PROBE_ENABLE
+/**
+ * @var g_alertStart
+ * @brief Timestamp of the first raw reading within the danger threshold, valid while g_alertPending.
+ *
+ * Recorded by PROBE_ALERT_LATENCY when the danger alert starts, so the probe covers the filter
+ * delay and the task periods between the echo and the buzzer on the target.
+ */
+static uint32 g_alertStart = 0;
+static boolean g_alertPending = FALSE;
+#endif
+
+/**
+ * @var g_pingInterval
+ * @brief Current ping interval of the sensors in ms.
+ */
+static uint16 g_pingInterval = ULTRASONIC_MIN_CYCLE_MS;
+
+/**
+ * @var g_idleSince
+ * @brief Scheduler tick of the last run that was not in IDLE or had a raw reading in range.
+ */
+static uint32 g_idleSince = 0;
+
+/**
+ * @var g_closingSpeed
+ * @brief Smoothed speed of the nearest obstacle towards the sensors in mm/s, negative when receding.
+ */
+static sint16 g_closingSpeed = 0;
+
+/**
+ * @var g_speedDistance
+ * @brief Nearest distance of the previous closing speed update in mm.
+ */
+static uint16 g_speedDistance = ULTRASONIC_NO_ECHO_DISTANCE;
+
+/**
+ * @var g_speedTicks
+ * @brief Scheduler tick of the previous closing speed update.
+ */
+static uint32 g_speedTicks = 0;
+
+/**
+ * @var g_appTasks
+ * @brief Static task table of the application, stored in flash memory.
+ *
+ * The offsets spread the tasks over different ticks so that no tick runs all of them.
+ */
+static const Scheduler_TaskType g_appTasks[] PROGMEM = {
+    { APP_senseTask,   APP_SENSE_PERIOD_MS / SCHEDULER_TICK_MS,   APP_SENSE_OFFSET_MS / SCHEDULER_TICK_MS },
+    { APP_displayTask, APP_DISPLAY_PERIOD_MS / SCHEDULER_TICK_MS, 5 },
+    { APP_telemetryTask, APP_TELEMETRY_PERIOD_MS / SCHEDULER_TICK_MS, 20 },
+    { Calibration_update, APP_CALIBRATION_PERIOD_MS / SCHEDULER_TICK_MS, 40 },
+    { Settings_process, APP_SETTINGS_PERIOD_MS / SCHEDULER_TICK_MS, APP_SETTINGS_OFFSET_MS / SCHEDULER_TICK_MS }
+};
+
+/**
+ * @brief Main application entry point.
+ *
+ * Initializes all hardware components and continuously monitors the distance
+ * to manage the state machine.
+ *
+ * @return This function does not return a value.
+ */
+int main(void) {
+    uint8 i;
+
+    /* Start the tick first, the LCD driver times its commands with the Timer0 timestamp
+     * and the ultrasonic round-robin runs on its tick */
+    Scheduler_init(g_appTasks, sizeof(g_appTasks) / sizeof(g_appTasks[0]));
+    Power_init();          /**< Sleep in idle mode whenever no task is released */
+    Health_init();         /**< Arm the watchdog, a hang from here on resets the MCU */
+
+    /* Initialize hardware components, the sensor first so that it is pinged on the next tick.
+     * Nothing below blocks: the LCD power-up and init sequence run from the Timer0 tick */
+    Ultrasonic_init();     /**< Initialize the ultrasonic sensor */
+    Calibration_init();    /**< Apply the calibration of the unit stored in EEPROM, before the first echo */
+    LED_init();            /**< Initialize the LED module */
+    LCD_init();            /**< Initialize the LCD display */
+    Buzzer_init();         /**< Initialize the buzzer */
+    Telemetry_init();      /**< Initialize the telemetry link */
+    APP_loadThresholds();  /**< Thresholds of the installation stored in EEPROM */
+    Telemetry_setCommandCallBack(APP_commandHandler);
+
+    /* Start every sensor with an empty filter window */
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        Filter_init(&g_filters[i]);
+        g_filtered[i] = FILTER_NO_SAMPLE;
+    }
+
+    /* Ensure the buzzer and LEDs match the initial state */
+    APP_applyOutputs(g_stateMachine);
+
+    /* Main loop running the released tasks, the watchdog is kicked once per pass */
+    for (;;) {
+        Scheduler_dispatch();
+        APP_watchStartup();
+        Health_kickWatchdog();
+    }
+}
+
+/**
+ * @brief Sensing task.
+ *
+ * The sensors are pinged in the background by the ultrasonic round-robin, so this task only
+ * filters the readings that arrived since its last run and takes the nearest filtered obstacle.
+ * Every reading is checked by the health monitor first, an out-of-range capture never enters the filter.
+ */
+void APP_senseTask(void) {
+    uint8 i;
+    uint8 l_count;
+    uint16 l_reading;
+    boolean l_new = FALSE;
+    boolean l_near = FALSE;
+    Ultrasonic_SampleType l_samples[ULTRASONIC_SAMPLE_RING_SIZE];
+    PROBE_BEGIN(PROBE_SENSE_TASK);
+
+    /* Every measurement since the last run enters the filter of its sensor once, oldest first */
+    l_count = Ultrasonic_readSamples(l_samples, ULTRASONIC_SAMPLE_RING_SIZE);
+    for (i = 0; i < l_count; i++) {
+        l_new = TRUE;
+        if (!Health_checkSample(&l_samples[i])) {
+            continue;
+        }
+        l_reading = l_samples[i].distance;
+        g_filtered[l_samples[i].sensor] = Filter_update(&g_filters[l_samples[i].sensor], l_reading);
+#ifdef PROBE_ENABLE
+        if (l_reading > g_thresholds.dangerMm) {
+            g_alertPending = FALSE;    /**< A glitch the filter rejected, not an alert to wait for */
+        } else if (!g_alertPending && (g_stateMachine != DANGER)) {
+            g_alertStart = l_samples[i].timestamp; /**< The alert latency starts at the echo itself */
+            g_alertPending = TRUE;
+        }
+#endif
+        if (l_reading <= g_thresholds.detectedMaxMm) {
+            l_near = TRUE;
+        }
+    }
+    if (l_new) {
+        APP_recordStartup(APP_STARTUP_FIRST_SAMPLE);
+    }
+    Health_update();
+
+    g_distance = ULTRASONIC_NO_ECHO_DISTANCE;
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        if (g_filtered[i] < g_distance) {
+            g_distance = g_filtered[i];
+        }
+    }
+
+    /* Handle the state machine logic based on the distance */
+    StateMachineHandler();
+    if (l_new) {
+        APP_updateClosingSpeed();
+    }
+    APP_updatePingRate(l_near);
+    PROBE_END(PROBE_SENSE_TASK);
+}
+
+/**
+ * @brief Updates the closing speed estimate from the new nearest distance.
+ *
+ * The speed is the change of the filtered distance over the time since the previous update,
+ * smoothed once more since each filtered sample only moves part of the way. Losing the obstacle
+ * restarts the estimate from zero.
+ */
+void APP_updateClosingSpeed(void) {
+    uint32 l_now = Scheduler_getTicks();
+    uint32 l_elapsedMs = (l_now - g_speedTicks) * SCHEDULER_TICK_MS;
+    sint32 l_speed;
+
+    if (g_distance == ULTRASONIC_NO_ECHO_DISTANCE) {
+        g_closingSpeed = 0;
+    } else if ((g_speedDistance != ULTRASONIC_NO_ECHO_DISTANCE) && (l_elapsedMs != 0)) {
+        l_speed = (((sint32) g_speedDistance - (sint32) g_distance) * 1000L) / (sint32) l_elapsedMs;
+        if (l_speed > 32767L) {
+            l_speed = 32767L;
+        } else if (l_speed < -32767L) {
+            l_speed = -32767L;
+        }
+        g_closingSpeed += (sint16) ((l_speed - g_closingSpeed) / (1 << APP_SPEED_SHIFT));
+    }
+    g_speedDistance = g_distance;
+    g_speedTicks = l_now;
+}
+
+/**
+ * @brief Telemetry task.
+ *
+ * The raw echo is the one of the sensor with the nearest reading, the distance is the filtered one
+ * used by the state machine.
+ */
+void APP_telemetryTask(void) {
+    Telemetry_SampleType l_sample;
+    uint16 l_raw;
+    uint8 l_sensor;
+
+    Telemetry_poll();      /**< Commands received since the last frame */
+
+    l_sensor = Ultrasonic_getNearest(&l_raw);
+
+    l_sample.echoTicks = (l_sensor == ULTRASONIC_NO_SENSOR) ? 0 : Ultrasonic_getEchoTicks(l_sensor);
+    l_sample.distanceMm = g_distance;
+    l_sample.state = (uint8) g_stateMachine;
+    Telemetry_send(&l_sample);
+}
+
+/**
+ * @brief Checks thresholds and makes them the ones in use, precomputing the band of every state.
+ *
+ * The band table is what the state machine compares the distance with, so it never adds the
+ * hysteresis itself.
+ *
+ * @param a_thresholds The thresholds.
+ * @return FALSE if the thresholds are inconsistent, the ones in use are then kept.
+ */
+boolean APP_setThresholds(const APP_ThresholdsType *a_thresholds) {
+    if ((a_thresholds->dangerMm >= a_thresholds->warningMaxMm)
+            || (a_thresholds->warningMaxMm >= a_thresholds->safeMaxMm)
+            || (a_thresholds->safeMaxMm >= a_thresholds->detectedMaxMm)
+            || ((uint32) a_thresholds->detectedMaxMm + a_thresholds->hysteresisMm >= ULTRASONIC_NO_ECHO_DISTANCE)) {
+        return FALSE;
+    }
+
+    g_thresholds = *a_thresholds;
+    g_bands[IDLE].enterMax = 0;
+    g_bands[IDLE].exitMax = 0;
+    g_bands[DETECTED].enterMax = g_thresholds.detectedMaxMm;
+    g_bands[SAFE].enterMax = g_thresholds.safeMaxMm;
+    g_bands[WARNING].enterMax = g_thresholds.warningMaxMm;
+    g_bands[DANGER].enterMax = g_thresholds.dangerMm;
+    g_bands[DETECTED].exitMax = g_bands[DETECTED].enterMax + g_thresholds.hysteresisMm;
+    g_bands[SAFE].exitMax = g_bands[SAFE].enterMax + g_thresholds.hysteresisMm;
+    g_bands[WARNING].exitMax = g_bands[WARNING].enterMax + g_thresholds.hysteresisMm;
+    g_bands[DANGER].exitMax = g_bands[DANGER].enterMax + g_thresholds.hysteresisMm;
+    return TRUE;
+}
+
+/**
+ * @brief Loads the thresholds of the installation from the EEPROM, or the defaults.
+ *
+ * A record that is missing, corrupted or inconsistent leaves the defaults in use.
+ */
+void APP_loadThresholds(void) {
+    APP_ThresholdsType l_thresholds;
+
+    memcpy_P(&l_thresholds, &g_defaultThresholds, sizeof(l_thresholds));
+    APP_setThresholds(&l_thresholds);
+    if (Settings_load(SETTINGS_ADDRESS_THRESHOLDS, APP_THRESHOLDS_MAGIC, (uint8 *) &l_thresholds,
+            sizeof(l_thresholds))) {
+        APP_setThresholds(&l_thresholds);
+    }
+}
+
+/**
+ * @brief Gets the danger threshold in use.
+ *
+ * @return The largest distance of the DANGER state in mm.
+ */
+uint16 APP_getDangerMm(void) {
+    return g_thresholds.dangerMm;
+}
+
+/**
+ * @brief Handles a command frame received over the telemetry link and sends its reply.
+ *
+ * The thresholds travel as five 16-bit little endian values in mm: danger, warning, safe,
+ * detected and hysteresis. A set command applies them and queues their store in the EEPROM,
+ * which completes within 0.2 s of the reply, so a host waits that long before powering the unit
+ * down; the sensing is never held up by the write. The startup times travel as
+ * three 16-bit little endian values in ms, 0 for a milestone not reached yet. The calibration
+ * travels as the signed offset in mm, the Q15 gain and the flags byte, and its get reply adds the
+ * temperature the conversion was generated for, a signed 16-bit value in 0.1 C.
+ *
+ * @param a_payload The payload, the command byte first.
+ * @param a_length Length of the payload.
+ */
+void APP_commandHandler(const uint8 *a_payload, uint8 a_length) {
+    uint8 l_reply[2 + APP_THRESHOLDS_WIRE_SIZE];
+    uint8 l_length = 2;
+    uint16 l_values[APP_THRESHOLDS_WIRE_SIZE / 2];
+    APP_ThresholdsType l_thresholds;
+    Calibration_DataType l_calibration;
+    uint8 i;
+
+    l_reply[0] = a_payload[0] | TELEMETRY_REPLY_FLAG;
+    l_reply[1] = APP_STATUS_REJECTED;
+
+    if ((a_payload[0] == APP_COMMAND_SET_THRESHOLDS) && (a_length == 1 + APP_THRESHOLDS_WIRE_SIZE)) {
+        for (i = 0; i < APP_THRESHOLDS_WIRE_SIZE / 2; i++) {
+            l_values[i] = (uint16) a_payload[1 + 2 * i] | ((uint16) a_payload[2 + 2 * i] << 8);
+        }
+        l_thresholds.dangerMm = l_values[0];
+        l_thresholds.warningMaxMm = l_values[1];
+        l_thresholds.safeMaxMm = l_values[2];
+        l_thresholds.detectedMaxMm = l_values[3];
+        l_thresholds.hysteresisMm = l_values[4];
+        if (APP_setThresholds(&l_thresholds)) {
+            Settings_store(SETTINGS_ADDRESS_THRESHOLDS, APP_THRESHOLDS_MAGIC, (const uint8 *) &g_thresholds,
+                    sizeof(g_thresholds));
+            l_reply[1] = APP_STATUS_OK;
+        }
+    } else if ((a_payload[0] == APP_COMMAND_GET_STARTUP) && (a_length == 1)) {
+        for (i = 0; i < APP_STARTUP_EVENTS; i++) {
+            l_values[i] = (g_startupTimes[i] > 0xFFFFUL / SCHEDULER_TICK_MS)
+                    ? 0xFFFF : (uint16) (g_startupTimes[i] * SCHEDULER_TICK_MS);  /**< Saturated at 0xFFFF ms */
+            l_reply[l_length++] = (uint8) l_values[i];
+            l_reply[l_length++] = (uint8) (l_values[i] >> 8);
+        }
+        l_reply[1] = APP_STATUS_OK;
+    } else if ((a_payload[0] == APP_COMMAND_GET_THRESHOLDS) && (a_length == 1)) {
+        l_values[0] = g_thresholds.dangerMm;
+        l_values[1] = g_thresholds.warningMaxMm;
+        l_values[2] = g_thresholds.safeMaxMm;
+        l_values[3] = g_thresholds.detectedMaxMm;
+        l_values[4] = g_thresholds.hysteresisMm;
+        for (i = 0; i < APP_THRESHOLDS_WIRE_SIZE / 2; i++) {
+            l_reply[l_length++] = (uint8) l_values[i];
+            l_reply[l_length++] = (uint8) (l_values[i] >> 8);
+        }
+        l_reply[1] = APP_STATUS_OK;
+    } else if ((a_payload[0] == APP_COMMAND_SET_CALIBRATION) && (a_length == 1 + APP_CALIBRATION_WIRE_SIZE)) {
+        l_calibration.offsetMm = (sint16) ((uint16) a_payload[1] | ((uint16) a_payload[2] << 8));
+        l_calibration.gain = (uint16) a_payload[3] | ((uint16) a_payload[4] << 8);
+        l_calibration.flags = a_payload[5];
+        if (Calibration_set(&l_calibration)) {
+            l_reply[1] = APP_STATUS_OK;
+        }
+    } else if ((a_payload[0] == APP_COMMAND_GET_CALIBRATION) && (a_length == 1)) {
+        Calibration_get(&l_calibration);
+        l_values[0] = (uint16) l_calibration.offsetMm;
+        l_values[1] = l_calibration.gain;
+        l_values[2] = (uint16) Calibration_getTemperature();
+        l_reply[l_length++] = (uint8) l_values[0];
+        l_reply[l_length++] = (uint8) (l_values[0] >> 8);
+        l_reply[l_length++] = (uint8) l_values[1];
+        l_reply[l_length++] = (uint8) (l_values[1] >> 8);
+        l_reply[l_length++] = l_calibration.flags;
+        l_reply[l_length++] = (uint8) l_values[2];
+        l_reply[l_length++] = (uint8) (l_values[2] >> 8);
+        l_reply[1] = APP_STATUS_OK;
+    }
+
+    Telemetry_sendFrame(l_reply, l_length);
+}
+
+/**
+ * @brief Adapts the ping interval of the sensors to the state, the distance and the closing speed.
+ *
+ * While nothing is in range the interval grows by 1/8 per run, so the MCU and the sensor sleep
+ * longer between pings. It stops at APP_IDLE_PING_SHORT_MS for the first APP_IDLE_DWELL_MS, when
+ * an obstacle that just left is most likely to come back and the wait for its first reading adds
+ * to the alert latency, then goes on up to APP_IDLE_PING_MAX_MS. The first raw reading within
+ * range, before the median filter has confirmed it, restores the full rate so that the state
+ * machine gets its samples quickly.
+ *
+ * In range, a static obstacle is pinged every APP_PING_MS_PER_MM per mm of distance, up to
+ * APP_RANGE_PING_MAX_MS, and an
+ * approaching one often enough to get APP_PINGS_BEFORE_DANGER samples before it reaches
+ * the danger threshold at its closing speed, whichever is faster. The interval never goes below the
+ * ULTRASONIC_MIN_CYCLE_MS of the HC-SR04, which the danger state and the fastest approaches get,
+ * as well as the fault state so that the recovery of the sensor is seen quickly.
+ *
+ * @param a_near TRUE if a raw reading of this run was within the detected threshold.
+ */
+void APP_updatePingRate(boolean a_near) {
+    uint16 l_interval = g_pingInterval;
+    uint16 l_ceiling = APP_RANGE_PING_MAX_MS;
+    uint32 l_now = Scheduler_getTicks();
+    uint32 l_approach;
+
+    if ((g_stateMachine != IDLE) || a_near) {
+        g_idleSince = l_now;
+    }
+
+    if (g_stateMachine == IDLE) {
+        l_ceiling = ((l_now - g_idleSince) * SCHEDULER_TICK_MS >= APP_IDLE_DWELL_MS)
+                ? APP_IDLE_PING_MAX_MS : APP_IDLE_PING_SHORT_MS;
+        if (a_near) {
+            l_interval = ULTRASONIC_MIN_CYCLE_MS;
+        } else if (l_interval < l_ceiling) {
+            l_interval += l_interval >> 3;
+        }
+    } else if ((g_stateMachine == FAULT) || (g_distance <= g_thresholds.dangerMm)) {
+        l_interval = ULTRASONIC_MIN_CYCLE_MS;
+    } else {
+        l_interval = g_distance * APP_PING_MS_PER_MM;
+        if (g_closingSpeed > 0) {
+            /* Time to reach the danger distance in ms, shared between the wanted samples */
+            l_approach = ((uint32) (g_distance - g_thresholds.dangerMm) * 1000UL)
+                    / ((uint32) g_closingSpeed * APP_PINGS_BEFORE_DANGER);
+            if (l_approach < l_interval) {
+                l_interval = (uint16) l_approach;
+            }
+        }
+    }
+
+    if (l_interval < ULTRASONIC_MIN_CYCLE_MS) {
+        l_interval = ULTRASONIC_MIN_CYCLE_MS;
+    } else if (l_interval > l_ceiling) {
+        l_interval = l_ceiling;
+    }
+
+    if (l_interval != g_pingInterval) {
+        g_pingInterval = l_interval;
+        Ultrasonic_setPingInterval(l_interval);
+    }
+}
+
+/**
+ * @brief Display refresh task.
+ */
+void APP_displayTask(void) {
+    uint8 l_flags = pgm_read_byte(&g_stateOutputs[g_stateMachine].flags);
+
+    if (l_flags & APP_OUTPUT_STOP) {
+        LCD_dispDataDanger(); /**< Display danger message on the LCD */
+    } else if (l_flags & APP_OUTPUT_FAULT) {
+        LCD_dispDataFault();  /**< Display fault message on the LCD */
+    } else {
+        PROBE_BEGIN(PROBE_DISPLAY_NORM);
+        LCD_dispDataNorm();   /**< Display normal distance on the LCD */
+        PROBE_END(PROBE_DISPLAY_NORM);
+    }
+
+    /* Send only the cells that changed since the previous refresh */
+    PROBE_BEGIN(PROBE_LCD_FLUSH);
+    if (LCD_flush()) {
+        g_frameFlushed = TRUE;
+    }
+    PROBE_END(PROBE_LCD_FLUSH);
+}
+
+/**
+ * @brief Records the scheduler tick of a startup milestone the first time it is reached.
+ *
+ * @param a_event The milestone (APP_StartupEventType).
+ */
+void APP_recordStartup(uint8 a_event) {
+    if (g_startupTimes[a_event] == 0) {
+        g_startupTimes[a_event] = Scheduler_getTicks();
+    }
+}
+
+/**
+ * @brief Records the first LCD frame, polled after every dispatch until it is shown.
+ *
+ * The LCD is ready once the init sequence and the queued cells are executed, so the time covers
+ * its power-up as well as the first refresh.
+ */
+void APP_watchStartup(void) {
+    if ((g_startupTimes[APP_STARTUP_FIRST_FRAME] == 0) && g_frameFlushed && LCD_isReady()) {
+        APP_recordStartup(APP_STARTUP_FIRST_FRAME);
+    }
+}
+
+/**
+ * @brief Applies the outputs of a state from the output table.
+ *
+ * The LED brightness and blinking run on their own from the Timer0 tick, the buzzer patterns
+ * from the Timer2 interrupt.
+ *
+ * @param a_state The state just entered.
+ */
+void APP_applyOutputs(uint8 a_state) {
+    uint8 l_flags = pgm_read_byte(&g_stateOutputs[a_state].flags);
+    uint8 l_leds = pgm_read_byte(&g_stateOutputs[a_state].ledMask);
+
+    LED_setEffect(APP_LED_ALL & ~l_leds, 0, 0);  /**< The LEDs left out of the state are off */
+    LED_setEffect(l_leds, pgm_read_byte(&g_stateOutputs[a_state].ledDuty),
+            (l_flags & APP_OUTPUT_BLINK) ? APP_BLINK_PERIOD_MS : 0);
+    if (l_flags & APP_OUTPUT_FAULT) {
+        Buzzer_playPattern(BUZZER_PATTERN_FAULT);
+    } else if (l_flags & APP_OUTPUT_BEEP) {
+        Buzzer_playPattern(BUZZER_PATTERN_DANGER);
+        APP_recordStartup(APP_STARTUP_FIRST_ALERT);
+#ifdef PROBE_ENABLE
+        if (g_alertPending) {
+            Probe_record(PROBE_ALERT_LATENCY, Timer0_getTimestamp() - g_alertStart);
+            g_alertPending = FALSE;
+        }
+#endif
+    } else if (l_flags & APP_OUTPUT_CADENCE) {
+        APP_updateCadence();
+    } else {
+        Buzzer_off();
+    }
+}
+
+/**
+ * @brief Scales the beep cadence of the buzzer with the current distance, like a parking sensor.
+ *
+ * The pause gets one BUZZER_UNIT_MS unit per mm beyond the danger threshold, so the beeps run
+ * together as the obstacle approaches the danger distance.
+ */
+void APP_updateCadence(void) {
+    uint16 l_pause = (g_distance > g_thresholds.dangerMm) ? (g_distance - g_thresholds.dangerMm) : 0;
+
+    Buzzer_setCadence(APP_BEEP_ON_UNITS, (l_pause > 0xFF) ? 0xFF : (uint8) l_pause);
+}
+
+/**
+ * @brief State machine handler.
+ *
+ * This function moves the state towards DANGER while the distance is within the enter threshold
+ * of the next closer band, then towards IDLE while it is beyond the exit threshold of the current
+ * band. Outputs are only driven when the state actually changed.
+ *
+ * A faulty sensor overrides the distance: its readings may hold a phantom obstacle or hide a real
+ * one, so the fault is shown instead. Once the sensor recovered the state is found again from IDLE.
+ */
+void StateMachineHandler(void) {
+    uint8 l_state = g_stateMachine;
+    PROBE_BEGIN(PROBE_STATE_MACHINE);
+
+    if (Health_isFaulty()) {
+        l_state = FAULT;
+    } else {
+        if (l_state == FAULT) {
+            l_state = IDLE;
+        }
+
+        /* Enter closer states at their enter threshold */
+        while ((l_state < DANGER) && (g_distance <= g_bands[l_state + 1].enterMax)) {
+            l_state++;
+        }
+
+        /* Leave the current state only beyond its exit threshold */
+        while ((l_state > IDLE) && (g_distance > g_bands[l_state].exitMax)) {
+            l_state--;
+        }
+    }
+
+    if (l_state != g_stateMachine) {
+        g_stateMachine = (STATE_MACHINE) l_state;
+        APP_applyOutputs(l_state);  /**< Outputs change on transitions only */
+    } else if (pgm_read_byte(&g_stateOutputs[l_state].flags) & APP_OUTPUT_CADENCE) {
+        APP_updateCadence();        /**< Except the cadence that follows the distance */
+    }
+    PROBE_END(PROBE_STATE_MACHINE);
+}
+
+/**
+ * @brief Displays the normal distance reading on the LCD.
+ *
+ * In LCD_BAR_GRAPH_MODE the first row is a proximity bar that fills up as the obstacle gets
+ * closer than the detected threshold, with one step per pixel column. Otherwise this function writes
+ * the current distance measured by the ultrasonic sensor along with the unit 'cm' into the
+ * first row of the LCD framebuffer.
+ * Only the characters that changed are sent by the next LCD_flush().
+ */
+void LCD_dispDataNorm(void) {
+#ifdef LCD_BAR_GRAPH_MODE
+    uint8 l_level = 0;                                  /**< Lit steps of the bar, 0 when out of range */
+
+    uint16 l_range = g_thresholds.detectedMaxMm;       /**< Distance of an empty bar, it is full at 0 mm */
+
+    if (g_distance < l_range) {
+        l_level = (uint8) (((uint32) (l_range - g_distance) * APP_BAR_STEPS) / l_range);
+    }
+    LCD_bufferBar(0, 0, LCD_COLUMNS, l_level);          /**< A move of one step rewrites one or two cells */
+#else
+    uint8 l_col;                                        /**< Next free column of the first row */
+
+    l_col = LCD_bufferString_P(0, 0, PSTR("Distance= "));  /**< Display label for distance, read from flash */
+    l_col = LCD_bufferNumber(0, l_col, g_distance / 10, APP_DISTANCE_DIGITS); /**< Distance in cm, dashes when out of range */
+    l_col = LCD_bufferString_P(0, l_col, PSTR("cm"));      /**< Display the unit 'cm' */
+    LCD_bufferFill(0, l_col, LCD_BLANK_CHAR);              /**< Erase the rest of the STOP message */
+#endif
+}
+
+/**
+ * @brief Displays a "STOP" danger message on the LCD.
+ *
+ * This function writes a "STOP" message into the first row of the LCD framebuffer
+ * to warn the user of immediate danger.
+ */
+void LCD_dispDataDanger(void) {
+    LCD_bufferString_P(0, 0, PSTR("      STOP      ")); /**< Display the "STOP" message, read from flash */
+}
+
+/**
+ * @brief Displays a "SENSOR FAULT" message on the LCD.
+ *
+ * This function writes a "SENSOR FAULT" message into the first row of the LCD framebuffer
+ * while the readings of a sensor cannot be trusted.
+ */
+void LCD_dispDataFault(void) {
+    LCD_bufferString_P(0, 0, PSTR("  SENSOR FAULT  ")); /**< Display the fault message, read from flash */
+}
@@ -1,27 +1,183 @@
-#include"../mcal/gpio.h"
-#include"../common/std_types.h"
-#include"buzzer.h"
-
-void Buzzer_init() {
-
-		GPIO_ARR_setPinDirection(BUZZER_PIN, PIN_OUTPUT);
-
-}
-
-void Buzzer_on() {
-#ifdef BUZZER_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(BUZZER_PIN, LOGIC_HIGH);
-#else
-	GPIO_ARR_setPinState(BUZZER_PIN,LOGIC_LOW);
-#endif
-
-}
-
-void Buzzer_off() {
-#ifdef BUZZER_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(BUZZER_PIN, LOGIC_LOW);
-#else
-	GPIO_ARR_setPinState(BUZZER_PIN,LOGIC_HIGH);
-#endif
-
-}
+#include"../mcal/gpio.h"
+#include"../mcal/timer2.h"
+#include"../common/std_types.h"
+#include"buzzer.h"
+#include"../mcal/atmega32_regs.h"
+#include<avr/pgmspace.h>
+#include<avr/interrupt.h>
+
+/* Steps of all the patterns, each pattern repeats its own steps */
+static const Buzzer_StepType g_patternSteps[] PROGMEM = {
+	{ 1, 0 },                       /* CONTINUOUS */
+	{ 10, 10 },                     /* DANGER: 100 ms beeps */
+	{ 5, 5 }, { 5, 5 }, { 5, 30 },  /* ALARM: three short beeps then a pause */
+	{ 5, 10 }, { 5, 180 }           /* FAULT: two chirps every two seconds */
+};
+
+/* First step and number of steps of every Buzzer_PatternType */
+static const uint8 g_patterns[][2] PROGMEM = {
+	{ 0, 1 }, { 1, 1 }, { 2, 3 }, { 5, 2 }
+};
+
+/* Tone: compare values of the sounding and quiet halves and ISRs per pattern unit */
+static volatile uint8 g_highCompare = 124;
+static volatile uint8 g_lowCompare = 124;
+static volatile uint16 g_isrPerUnit = 40;
+
+/* Pattern state, only touched by the Timer2 ISR once the pattern is started */
+static volatile uint8 g_firstStep = 0;
+static volatile uint8 g_stepCount = 0; /* 0 plays g_cadence instead of the flash table */
+static uint8 g_running = 0;
+static uint8 g_step = 0;
+static uint8 g_phaseHigh = 0;
+static uint8 g_sounding = 0;
+static uint16 g_isrCount = 0;
+static uint8 g_unitsLeft = 0;
+static volatile Buzzer_StepType g_cadence = { 1, 0 };
+
+static void Buzzer_pin(uint8 a_on) {
+#ifdef BUZZER_POSTIVE_LOGIC
+	GPIO_FAST_SET(BUZZER_PIN, a_on ? LOGIC_HIGH : LOGIC_LOW);
+#else
+	GPIO_FAST_SET(BUZZER_PIN, a_on ? LOGIC_LOW : LOGIC_HIGH);
+#endif
+}
+
+/* Reads the current step from the flash table or the cadence */
+static void Buzzer_readStep(Buzzer_StepType *a_step) {
+	if (g_stepCount == 0) {
+		a_step->onUnits = g_cadence.onUnits;
+		a_step->offUnits = g_cadence.offUnits;
+	} else {
+		a_step->onUnits = pgm_read_byte(&g_patternSteps[g_firstStep + g_step].onUnits);
+		a_step->offUnits = pgm_read_byte(&g_patternSteps[g_firstStep + g_step].offUnits);
+	}
+}
+
+/*
+ * Timer2 compare callback: alternates the two halves of the tone period and advances the pattern,
+ * so beeping costs nothing in the main loop.
+ */
+static void Buzzer_timerProcessing(void) {
+	Buzzer_StepType l_step;
+
+	g_phaseHigh ^= 1;
+	Timer2_setCompareValue(g_phaseHigh ? g_highCompare : g_lowCompare);
+#ifdef BUZZER_ACTIVE
+	Buzzer_pin(g_sounding);
+#else
+	Buzzer_pin(g_sounding && g_phaseHigh);
+#endif
+
+	if (++g_isrCount < g_isrPerUnit) {
+		return;
+	}
+	g_isrCount = 0;
+	if (--g_unitsLeft != 0) {
+		return;
+	}
+
+	Buzzer_readStep(&l_step);
+	if (g_sounding && l_step.offUnits != 0) {
+		g_sounding = 0;                 /* Pause of the current step */
+		g_unitsLeft = l_step.offUnits;
+		return;
+	}
+	if (!g_sounding && g_stepCount != 0) {
+		g_step++;                       /* Next step, wrapping to the first one */
+		if (g_step >= g_stepCount) {
+			g_step = 0;
+		}
+		Buzzer_readStep(&l_step);
+	}
+	g_sounding = 1;
+	g_unitsLeft = l_step.onUnits;
+}
+
+/* Starts Timer2 from the first step of the selected cadence */
+static void Buzzer_start(void) {
+	Buzzer_StepType l_step;
+	Timer2_ConfigType l_config = { BUZZER_TIMER2_CLOCK, 0 };
+
+	Timer2_deInit();
+	l_config.compareValue = g_highCompare;
+	g_step = 0;
+	g_phaseHigh = 1;
+	g_sounding = 1;
+	g_isrCount = 0;
+	Buzzer_readStep(&l_step);
+	g_unitsLeft = l_step.onUnits;
+	Buzzer_pin(1);
+	g_running = 1;
+	Timer2_init(&l_config);
+}
+
+void Buzzer_init() {
+
+		GPIO_ARR_setPinDirection(BUZZER_PIN, PIN_OUTPUT);
+		Timer2_setCallBack(Buzzer_timerProcessing);
+		Buzzer_setTone(BUZZER_TONE_HZ, BUZZER_TONE_DUTY);
+
+}
+
+void Buzzer_setTone(uint16 a_frequency, uint8 a_duty) {
+	uint16 l_period, l_high;
+	uint8 l_sreg;
+
+	/* Both halves must fit the 8-bit compare register */
+	if (a_frequency < BUZZER_TIMER2_HZ / 512) {
+		a_frequency = BUZZER_TIMER2_HZ / 512;
+	}
+	if (a_duty > 100) {
+		a_duty = 100;
+	}
+	l_period = BUZZER_TIMER2_HZ / a_frequency;
+	l_high = (uint16) (((uint32) l_period * a_duty) / 100);
+	if (l_high < 1) {
+		l_high = 1;
+	} else if (l_high > l_period - 1) {
+		l_high = l_period - 1;
+	}
+	if (l_high > 256) {
+		l_high = 256;
+	}
+	if (l_period - l_high > 256) {
+		l_period = l_high + 256;
+	}
+
+	/* Written with interrupts disabled, a running tone picks the new halves up at its next compare match */
+	l_sreg = SREG_REG.byte;
+	cli();
+	g_highCompare = l_high - 1;
+	g_lowCompare = l_period - l_high - 1;
+	g_isrPerUnit = (uint16) ((2UL * a_frequency * BUZZER_UNIT_MS) / 1000);
+	SREG_REG.byte = l_sreg;
+}
+
+void Buzzer_playPattern(Buzzer_PatternType a_pattern) {
+	Timer2_deInit(); /* The ISR must not run on a half updated pattern */
+	g_firstStep = pgm_read_byte(&g_patterns[a_pattern][0]);
+	g_stepCount = pgm_read_byte(&g_patterns[a_pattern][1]);
+	Buzzer_start();
+}
+
+void Buzzer_setCadence(uint8 a_onUnits, uint8 a_offUnits) {
+	/* Single bytes read by the ISR at the end of a step, a running cadence just continues with them */
+	g_cadence.onUnits = a_onUnits ? a_onUnits : 1;
+	g_cadence.offUnits = a_offUnits;
+	if (!g_running || g_stepCount != 0) {
+		Timer2_deInit(); /* The ISR must not run on a half updated pattern */
+		g_stepCount = 0;
+		Buzzer_start();
+	}
+}
+
+void Buzzer_on() {
+	Buzzer_playPattern(BUZZER_PATTERN_CONTINUOUS);
+}
+
+void Buzzer_off() {
+	Timer2_deInit();
+	g_running = 0;
+	Buzzer_pin(0);
+}
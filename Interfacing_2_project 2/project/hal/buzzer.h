@@ -1,21 +1,54 @@
-/*
- * buzzer.h
- *
- *  Created on: 8 Oct 2024
- *      Author: MSI
- */
-
-#ifndef BUZZER_H_
-#define BUZZER_H_
-
-#define BUZZER_PIN GPIO_PC5
-#define BUZZER_POSTIVE_LOGIC
-
-#ifndef BUZZER_POSTIVE_LOGIC
-#define BUZZER_NEGATIVE_LOGIC
-#endif
-void Buzzer_init();
-void Buzzer_off();
-void Buzzer_on();
-
-#endif /* BUZZER_H_ */
+/*
+ * buzzer.h
+ *
+ *  Created on: 8 Oct 2024
+ *      Author: MSI
+ */
+
+#ifndef BUZZER_H_
+#define BUZZER_H_
+
+#define BUZZER_PIN GPIO_PC5
+#define BUZZER_POSTIVE_LOGIC
+
+#ifndef BUZZER_POSTIVE_LOGIC
+#define BUZZER_NEGATIVE_LOGIC
+#endif
+
+/* Uncomment for a buzzer with its own oscillator, the pin is then held on instead of toggled at the tone
+#define BUZZER_ACTIVE
+*/
+
+/* OC2 (PD7) drives the ultrasonic trigger, so the Timer2 compare ISR toggles BUZZER_PIN itself */
+#define BUZZER_TIMER2_CLOCK TIMER2_F_CPU_32
+#define BUZZER_TIMER2_HZ (F_CPU / 32UL)
+#define BUZZER_TONE_HZ 2000
+#define BUZZER_TONE_DUTY 50
+
+/* Pattern steps are counted in units of BUZZER_UNIT_MS */
+#define BUZZER_UNIT_MS 10
+
+/* One step of a cadence: the tone sounds onUnits then pauses offUnits, offUnits = 0 never pauses */
+typedef struct {
+	uint8 onUnits;
+	uint8 offUnits;
+} Buzzer_StepType;
+
+/* Cadences of the flash pattern table */
+typedef enum {
+	BUZZER_PATTERN_CONTINUOUS, BUZZER_PATTERN_DANGER, BUZZER_PATTERN_ALARM, BUZZER_PATTERN_FAULT
+} Buzzer_PatternType;
+
+void Buzzer_init();
+/* Stops the tone and any pattern */
+void Buzzer_off();
+/* Sounds the tone continuously */
+void Buzzer_on();
+/* Sets the tone frequency (at least BUZZER_TIMER2_HZ / 512) and duty in percent, applied now */
+void Buzzer_setTone(uint16, uint8);
+/* Plays a cadence of the flash pattern table repeatedly from the Timer2 ISR */
+void Buzzer_playPattern(Buzzer_PatternType);
+/* Plays a single repeating step, changing it only moves the next step so a sounding beep is never cut */
+void Buzzer_setCadence(uint8, uint8);
+
+#endif /* BUZZER_H_ */
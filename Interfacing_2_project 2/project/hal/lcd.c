@@ -1,218 +1,1002 @@
-/**
- * @file lcd.c
- * @brief LCD Hardware Abstraction Layer (HAL) implementation.
- *
- * This file provides the implementation for controlling a 2x16 character LCD.
- * It includes functions to send commands and characters to the LCD, initialize the LCD,
- * display strings, move the cursor, and perform other operations.
- *
- * @date 27 Sept 2024
- * @author Ibrahim Mohsen
- */
-
-#include "../mcal/gpio.h"
-#include "../common/common_macros.h"
-#include "lcd.h"
-#include <util/delay.h>
-#include <stdlib.h>
-#include <avr/io.h>
-
-/**
- * @brief Sends a command to the LCD.
- *
- * This function sends a command to the LCD to perform specific operations
- * such as clearing the screen, setting display modes, or moving the cursor.
- *
- * @param a_lcdCommand The command to be sent to the LCD (e.g., LCD_CLEAR_SCREEN_COMMAND).
- */
-void LCD_sendCommand(uint8 a_lcdCommand) {
-	GPIO_ARR_setPinState(LCD_RS, LOW); /* Set RS to 0 for command mode */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, HIGH); /* Enable the LCD */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-
-#ifdef LCD_8_BIT_MODE
-    GPIO_writePort(LCD_DATA_PORT, a_lcdChar);  /* Send character to data port */
-    _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, LOW);    /* Disable the LCD to latch the character */
-    _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-#else
-	GPIO_ARR_setPinState(LCD_D4, GET_BIT(a_lcdCommand, 4));
-	GPIO_ARR_setPinState(LCD_D5, GET_BIT(a_lcdCommand, 5));
-	GPIO_ARR_setPinState(LCD_D6, GET_BIT(a_lcdCommand, 6));
-	GPIO_ARR_setPinState(LCD_D7, GET_BIT(a_lcdCommand, 7));
-	_delay_us(LCD_TA_DELAY_US);
-	GPIO_ARR_setPinState(LCD_E, LOW); /* Disable the LCD to latch the character */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, HIGH); /* Enable the LCD */
-	GPIO_ARR_setPinState(LCD_D4, GET_BIT(a_lcdCommand, 0));
-	GPIO_ARR_setPinState(LCD_D5, GET_BIT(a_lcdCommand, 1));
-	GPIO_ARR_setPinState(LCD_D6, GET_BIT(a_lcdCommand, 2));
-	GPIO_ARR_setPinState(LCD_D7, GET_BIT(a_lcdCommand, 3));
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, LOW); /* Disable the LCD to latch the character */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-
-#endif
-}
-
-/**
- * @brief Sends a character to the LCD to be displayed at the current cursor position.
- *
- * This function sends a single character to the LCD for display.
- * It sets the RS pin to 1 to indicate that the data is a character.
- *
- * @param a_lcdChar The ASCII character to be sent to the LCD.
- */
-void LCD_displayChar(uint8 a_lcdChar) {
-	GPIO_ARR_setPinState(LCD_RS, HIGH); /* Set RS to 1 for data mode */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, HIGH); /* Enable the LCD */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-#ifdef LCD_8_BIT_MODE
-    GPIO_writePort(LCD_DATA_PORT, a_lcdChar);  /* Send character to data port */
-    _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, LOW);    /* Disable the LCD to latch the character */
-    _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-#else
-	GPIO_ARR_setPinState(LCD_D4, GET_BIT(a_lcdChar, 4));
-	GPIO_ARR_setPinState(LCD_D5, GET_BIT(a_lcdChar, 5));
-	GPIO_ARR_setPinState(LCD_D6, GET_BIT(a_lcdChar, 6));
-	GPIO_ARR_setPinState(LCD_D7, GET_BIT(a_lcdChar, 7));
-	_delay_us(LCD_TA_DELAY_US);
-	GPIO_ARR_setPinState(LCD_E, LOW); /* Disable the LCD to latch the character */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, HIGH); /* Enable the LCD */
-	GPIO_ARR_setPinState(LCD_D4, GET_BIT(a_lcdChar, 0));
-	GPIO_ARR_setPinState(LCD_D5, GET_BIT(a_lcdChar, 1));
-	GPIO_ARR_setPinState(LCD_D6, GET_BIT(a_lcdChar, 2));
-	GPIO_ARR_setPinState(LCD_D7, GET_BIT(a_lcdChar, 3));
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-	GPIO_ARR_setPinState(LCD_E, LOW); /* Disable the LCD to latch the character */
-	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
-
-#endif
-}
-
-/**
- * @brief Initializes the LCD in 8-bit mode with 2 display lines.
- *
- * This function configures the LCD by setting the appropriate modes (2-line, 8-bit),
- * turning off the cursor, and clearing the display. It should be called once during initialization.
- */
-void LCD_init() {
-	GPIO_ARR_setPinDirection(LCD_RS, PIN_OUTPUT); /* Set RS pin as output */
-	GPIO_ARR_setPinDirection(LCD_E, PIN_OUTPUT); /* Set E pin as output */
-	_delay_ms(20); /* Wait for LCD to power up */
-#ifdef LCD_8_BIT_MODE
-    GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT);  /* Set data port as output */
-    LCD_sendCommand(LCD_TWO_LINE_EIGHT_BIT_COMMAND);  /* Set LCD to 2 lines, 8-bit mode */
-#else
-	GPIO_ARR_setPinDirection(LCD_D4, PIN_OUTPUT);
-	GPIO_ARR_setPinDirection(LCD_D5, PIN_OUTPUT);
-	GPIO_ARR_setPinDirection(LCD_D6, PIN_OUTPUT);
-	GPIO_ARR_setPinDirection(LCD_D7, PIN_OUTPUT);
-	/* Send for 4 bit initialization of LCD  */
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2);
-
-	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE);
-#endif
-
-	LCD_sendCommand(LCD_CURSOR_OFF_COMMAND); /* Turn off cursor */
-	LCD_sendCommand(LCD_CLEAR_SCREEN_COMMAND); /* Clear the LCD screen */
-	LCD_moveCursor(0,0);
-}
-
-/**
- * @brief Displays a string on the LCD starting from the current cursor position.
- *
- * This function sends a null-terminated string to the LCD. The string is displayed starting
- * at the current cursor location. The function will not display more than the maximum number
- * of columns allowed by the LCD.
- *
- * @param a_lcdString Pointer to the null-terminated string to be displayed.
- * @return LCD_ERROR Returns SUCSSES if the string fits within the display, otherwise returns EXCEEDMAXCOLUMNS.
- */
-uint8 LCD_displayString(const char *a_lcdString) {
-	int i = 0;
-	while (a_lcdString[i] != '\0') {
-		LCD_displayChar(a_lcdString[i]); /* Send each character in the string */
-		if (i == LCD_MAX_COLUMNS_INDEX) /* Stop if maximum column index is reached */
-			break;
-		i++;
-	}
-	return i < LCD_COLUMNS ? SUCSSES : EXCEEDMAXCOLUMNS; /* Return appropriate status */
-}
-
-/**
- * @brief Moves the LCD cursor to a specific position.
- *
- * This function moves the cursor to the specified row and column on the LCD.
- * It calculates the appropriate memory address in the LCD and sends the cursor
- * position command.
- *
- * @param a_lcdRow The row to move the cursor to (0 to LCD_ROWS-1).
- * @param a_lcdCol The column to move the cursor to (0 to LCD_MAX_COLUMNS_INDEX).
- */
-void LCD_moveCursor(uint8 a_lcdRow, uint8 a_lcdCol) {
-	uint8 lcd_memory_address;
-
-	/* Calculate the required address in the LCD DDRAM */
-	switch (a_lcdRow) {
-	case 0:
-		lcd_memory_address = a_lcdCol;
-		break;
-	case 1:
-		lcd_memory_address = a_lcdCol + LCD_ROW_1_OFFSET;
-		break;
-	case 2:
-		lcd_memory_address = a_lcdCol + LCD_ROW_2_OFFSET;
-		break;
-	case 3:
-		lcd_memory_address = a_lcdCol + LCD_ROW_3_OFFSET;
-		break;
-	}
-
-	/* Move the LCD cursor to this specific address */
-	LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
-}
-
-/**
- * @brief Displays a string starting at a specified row and column on the LCD.
- *
- * This function moves the cursor to the given row and column, then displays the provided string.
- *
- * @param row The row to start displaying the string (0 to LCD_ROWS-1).
- * @param col The column to start displaying the string (0 to LCD_MAX_COLUMNS_INDEX).
- * @param Str Pointer to the null-terminated string to be displayed.
- */
-void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str) {
-	LCD_moveCursor(row, col); /* Move to specified row and column */
-	LCD_displayString(Str); /* Display the string at the new cursor location */
-}
-
-/**
- * @brief Displays an integer on the LCD.
- *
- * This function converts an integer to its ASCII string representation and
- * displays the string on the LCD.
- *
- * @param data The integer value to be displayed.
- */
-void LCD_intgerToString(int data) {
-	char buff[16]; /* Buffer to hold ASCII representation of the integer */
-	itoa(data, buff, 10); /* Convert integer to string (base 10) */
-	LCD_displayString(buff); /* Display the resulting string on the LCD */
-}
-
-/**
- * @brief Clears the entire LCD display.
- *
- * This function sends the clear screen command to the LCD, clearing all the displayed
- * characters and resetting the cursor to the home position.
- */
-void LCD_clearScreen(void) {
-	LCD_sendCommand(LCD_CLEAR_SCREEN_COMMAND); /* Send clear display command */
-}
+/**
+ * @file lcd.c
+ * @brief LCD Hardware Abstraction Layer (HAL) implementation.
+ *
+ * This file provides the implementation for controlling a 2x16 character LCD.
+ * It includes functions to send commands and characters to the LCD, initialize the LCD,
+ * display strings, move the cursor, and perform other operations.
+ *
+ * @date 27 Sept 2024
+ * @author Ibrahim Mohsen
+ */
+
+#include "../mcal/gpio.h"
+#include "../common/common_macros.h"
+#include "lcd.h"
+#include "../mcal/timer0.h"
+#include <util/delay.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Number of bytes holding the dirty flags of one framebuffer row (one bit per cell).
+ */
+#define LCD_DIRTY_BYTES ((LCD_COLUMNS + 7) / 8)
+
+/**
+ * @brief RAM shadow of the characters shown on the LCD.
+ */
+static uint8 g_lcdFrame[LCD_ROWS][LCD_COLUMNS];
+
+/**
+ * @brief Per-cell dirty flags, bit (col % 8) of byte (col / 8) is set when the cell must be sent.
+ */
+static uint8 g_lcdDirty[LCD_ROWS][LCD_DIRTY_BYTES];
+
+/**
+ * @brief DDRAM address the LCD cursor points to, the LCD increments it after every character.
+ */
+static uint8 g_lcdAddress = 0;
+
+/**
+ * @brief Calculates the DDRAM address of a cell.
+ *
+ * @param a_lcdRow The row of the cell (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column of the cell (0 to LCD_MAX_COLUMNS_INDEX).
+ * @return The DDRAM address of the cell.
+ */
+static uint8 LCD_cellAddress(uint8 a_lcdRow, uint8 a_lcdCol) {
+	uint8 lcd_memory_address = a_lcdCol;
+
+	/* Calculate the required address in the LCD DDRAM */
+	switch (a_lcdRow) {
+	case 0:
+		lcd_memory_address = a_lcdCol;
+		break;
+	case 1:
+		lcd_memory_address = a_lcdCol + LCD_ROW_1_OFFSET;
+		break;
+	case 2:
+		lcd_memory_address = a_lcdCol + LCD_ROW_2_OFFSET;
+		break;
+	case 3:
+		lcd_memory_address = a_lcdCol + LCD_ROW_3_OFFSET;
+		break;
+	}
+	return lcd_memory_address;
+}
+
+/**
+ * @brief Resets the framebuffer to a blank and clean display.
+ */
+static void LCD_bufferReset(void) {
+	uint8 row, col;
+
+	for (row = 0; row < LCD_ROWS; row++) {
+		for (col = 0; col < LCD_COLUMNS; col++) {
+			g_lcdFrame[row][col] = LCD_BLANK_CHAR;
+		}
+		for (col = 0; col < LCD_DIRTY_BYTES; col++) {
+			g_lcdDirty[row][col] = 0;
+		}
+	}
+	g_lcdAddress = 0;
+}
+
+/**
+ * @brief Number of decimal digits of the largest uint16 value.
+ */
+#define LCD_MAX_DIGITS 5
+
+/**
+ * @brief Powers of ten of the digits of a uint16, most significant first, stored in flash memory.
+ */
+static const uint16 g_lcdPowersOfTen[LCD_MAX_DIGITS] PROGMEM = { 10000, 1000, 100, 10, 1 };
+
+/**
+ * @brief Takes one decimal digit off a value by repeated subtraction, at most 9 per digit.
+ *
+ * The AVR has no divide instruction, so this is cheaper than the division of itoa().
+ *
+ * @param a_value The value, reduced below the power of ten on return.
+ * @param a_power Index of the digit in g_lcdPowersOfTen.
+ * @return The ASCII digit.
+ */
+static uint8 LCD_nextDigit(uint16 *a_value, uint8 a_power) {
+	uint16 l_power = pgm_read_word(&g_lcdPowersOfTen[a_power]);
+	uint8 l_digit = '0';
+
+	while (*a_value >= l_power) {
+		*a_value -= l_power;
+		l_digit++;
+	}
+	return l_digit;
+}
+
+#ifdef LCD_BAR_GRAPH_MODE
+/**
+ * @brief Number of partial cell glyphs, a cell with no lit column is blank and a full one uses the ROM block.
+ */
+#define LCD_BAR_GLYPHS (LCD_BAR_STEPS_PER_CELL - 1)
+
+/**
+ * @brief Partial bar cells lighting 1 to 4 columns from the left, full height, stored in flash memory.
+ */
+static const uint8 g_lcdBarGlyphs[LCD_BAR_GLYPHS][LCD_GLYPH_ROWS] PROGMEM = {
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+	{ 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },
+	{ 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C },
+	{ 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E }
+};
+#endif
+
+#ifdef LCD_RW_MODE
+/**
+ * @brief The busy flag is only valid after the interface is configured, init uses the time table.
+ */
+static boolean g_lcdBusyFlagValid = FALSE;
+#endif
+
+/**
+ * @brief Kind of byte held by a transmit queue entry or of a byte of the init sequence.
+ */
+typedef enum {
+	LCD_ENTRY_COMMAND, /**< A command, written with RS = 0. */
+	LCD_ENTRY_DATA,    /**< A character, written with RS = 1. */
+	LCD_ENTRY_INIT     /**< A command switching the interface, written with RS = 0 and timed, never polled. */
+} LCD_EntryType;
+
+#ifdef LCD_ASYNC_MODE
+/**
+ * @brief Mask wrapping the free-running queue indices to a queue slot.
+ */
+#define LCD_QUEUE_MASK (LCD_QUEUE_SIZE - 1)
+
+/**
+ * @brief Transmit queue entry.
+ */
+typedef struct {
+	uint8 data;         /**< The command or character. */
+	LCD_EntryType type; /**< How the byte is written. */
+} LCD_QueueEntryType;
+
+/**
+ * @brief Transmit queue, filled by the caller and drained by the Timer0 tick.
+ *
+ * Volatile so the stores into a slot are never moved after the head update that publishes it.
+ */
+static volatile LCD_QueueEntryType g_lcdQueue[LCD_QUEUE_SIZE];
+
+/**
+ * @brief Free-running queue indices, only the caller writes the head and only the tick writes the tail.
+ */
+static volatile uint8 g_lcdQueueHead = 0;
+static volatile uint8 g_lcdQueueTail = 0;
+
+/**
+ * @brief Set once the queue drain is registered with Timer0.
+ */
+static boolean g_lcdQueueStarted = FALSE;
+#endif
+
+/**
+ * @brief Timer0 timestamp of the last write to the LCD.
+ */
+static uint32 g_lcdLastWrite = 0;
+
+/**
+ * @brief Timer0 clocks the LCD needs to execute the last write.
+ */
+static uint16 g_lcdBusyCounts = 0;
+
+/**
+ * @brief Minimum execution time of a command in Timer0 clocks, indexed by its highest set bit.
+ *
+ * Bit 0 is clear display and bit 1 is return home, every other instruction takes the same time.
+ */
+static const uint16 g_lcdCommandCounts[8] PROGMEM = {
+	LCD_US_TO_COUNTS(LCD_CLEAR_HOME_TIME_US),
+	LCD_US_TO_COUNTS(LCD_CLEAR_HOME_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US),
+	LCD_US_TO_COUNTS(LCD_COMMAND_TIME_US)
+};
+
+/**
+ * @brief Looks up the minimum execution time of a command.
+ *
+ * @param a_lcdCommand The command sent to the LCD.
+ * @return The execution time in Timer0 clocks.
+ */
+static uint16 LCD_commandCounts(uint8 a_lcdCommand) {
+	uint8 bit = 7;
+
+	while ((bit > 0) && BIT_IS_CLEAR(a_lcdCommand, bit)) {
+		bit--;
+	}
+	return pgm_read_word(&g_lcdCommandCounts[bit]);
+}
+
+/**
+ * @brief Looks up the minimum execution time of a command, a character or an init command.
+ *
+ * @param a_lcdData The byte sent to the LCD.
+ * @param a_type How the byte is written.
+ * @return The execution time in Timer0 clocks.
+ */
+static uint16 LCD_entryCounts(uint8 a_lcdData, LCD_EntryType a_type) {
+	if (a_type == LCD_ENTRY_DATA) {
+		return LCD_US_TO_COUNTS(LCD_DATA_WRITE_TIME_US);
+	} else if (a_type == LCD_ENTRY_INIT) {
+		return LCD_US_TO_COUNTS(LCD_INIT_COMMAND_TIME_US);
+	}
+	return LCD_commandCounts(a_lcdData);
+}
+
+#ifdef LCD_RW_MODE
+/**
+ * @brief Reads the busy flag (DB7) of the LCD.
+ *
+ * The data pins are switched to input for the read and back to output afterwards.
+ *
+ * @return HIGH while the LCD is busy, LOW when it is ready.
+ */
+static uint8 LCD_readBusyFlag(void) {
+	uint8 busy;
+
+#ifdef LCD_8_BIT_MODE
+	GPIO_setupPortDirection(LCD_DATA_PORT, PORT_INPUT);
+#else
+	GPIO_FAST_SET_DIRECTION(LCD_D4, PIN_INPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D5, PIN_INPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D6, PIN_INPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D7, PIN_INPUT);
+#endif
+	GPIO_FAST_SET(LCD_RS, LOW); /* RS = 0 and R/W = 1 reads the busy flag */
+	GPIO_FAST_SET(LCD_RW, HIGH);
+	_delay_us(LCD_TA_DELAY_US);
+	GPIO_FAST_SET(LCD_E, HIGH);
+	_delay_us(LCD_TA_DELAY_US);
+#ifdef LCD_8_BIT_MODE
+	busy = GPIO_readPin(LCD_DATA_PORT, 7);
+	GPIO_FAST_SET(LCD_E, LOW);
+	_delay_us(LCD_TA_DELAY_US);
+#else
+	busy = GPIO_FAST_READ(LCD_D7);
+	GPIO_FAST_SET(LCD_E, LOW);
+	_delay_us(LCD_TA_DELAY_US);
+	GPIO_FAST_SET(LCD_E, HIGH); /* Clock out the low nibble (address counter) */
+	_delay_us(LCD_TA_DELAY_US);
+	GPIO_FAST_SET(LCD_E, LOW);
+	_delay_us(LCD_TA_DELAY_US);
+#endif
+	GPIO_FAST_SET(LCD_RW, LOW);
+#ifdef LCD_8_BIT_MODE
+	GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT);
+#else
+	GPIO_FAST_SET_DIRECTION(LCD_D4, PIN_OUTPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D5, PIN_OUTPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D6, PIN_OUTPUT);
+	GPIO_FAST_SET_DIRECTION(LCD_D7, PIN_OUTPUT);
+#endif
+	return busy;
+}
+#endif
+
+/**
+ * @brief Checks if the execution time of the last write in the time table elapsed, without a bus access.
+ *
+ * @return TRUE if the LCD is ready, FALSE while it is still executing the last write.
+ */
+static boolean LCD_timedReady(void) {
+	return ((Timer0_getTimestamp() - g_lcdLastWrite) >= g_lcdBusyCounts);
+}
+
+/**
+ * @brief Checks if the LCD finished executing the last write.
+ *
+ * @return TRUE if the LCD is ready, FALSE while it is still executing the last write.
+ */
+static boolean LCD_busReady(void) {
+#ifdef LCD_RW_MODE
+	if (g_lcdBusyFlagValid) {
+		return (LCD_readBusyFlag() == LOW);
+	}
+#endif
+	return LCD_timedReady();
+}
+
+/**
+ * @brief Checks if the LCD can accept the next command or character.
+ *
+ * @return TRUE if the LCD is ready, FALSE while it is still executing the last write.
+ */
+boolean LCD_isReady(void) {
+#ifdef LCD_ASYNC_MODE
+	if (g_lcdQueueHead != g_lcdQueueTail) {
+		return FALSE;
+	}
+#endif
+	return LCD_busReady();
+}
+
+#ifndef LCD_8_BIT_MODE
+/**
+ * @brief TRUE when D4-D7 are four consecutive pins of one port, so the nibble is a single masked write.
+ */
+#define LCD_DATA_NIBBLE_CONTIGUOUS ((LCD_D5 == LCD_D4 + 1) && (LCD_D6 == LCD_D4 + 2) && \
+		(LCD_D7 == LCD_D4 + 3) && (GPIO_FAST_BIT(LCD_D4) <= 4))
+
+/**
+ * @brief Puts a nibble on D4-D7.
+ *
+ * The wiring is checked at compile time, the other branch is removed by the optimizer.
+ *
+ * @param a_nibble The nibble in the low four bits.
+ */
+static void LCD_writeNibble(uint8 a_nibble) {
+	if (LCD_DATA_NIBBLE_CONTIGUOUS) {
+		GPIO_FAST_WRITE_GROUP(LCD_D4, 4, a_nibble);
+	} else {
+		GPIO_FAST_SET(LCD_D4, GET_BIT(a_nibble, 0));
+		GPIO_FAST_SET(LCD_D5, GET_BIT(a_nibble, 1));
+		GPIO_FAST_SET(LCD_D6, GET_BIT(a_nibble, 2));
+		GPIO_FAST_SET(LCD_D7, GET_BIT(a_nibble, 3));
+	}
+}
+#endif
+
+/**
+ * @brief Writes one byte on the LCD bus, the caller makes sure the LCD is ready.
+ *
+ * @param a_lcdData The command or character to be written.
+ * @param a_lcdRs LOW for a command, HIGH for a character.
+ * @param a_busyCounts Timer0 clocks the LCD needs to execute this write.
+ */
+static void LCD_busWrite(uint8 a_lcdData, uint8 a_lcdRs, uint16 a_busyCounts) {
+	GPIO_FAST_SET(LCD_RS, a_lcdRs); /* RS = 0 for a command, 1 for a character */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+	GPIO_FAST_SET(LCD_E, HIGH); /* Enable the LCD */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+
+#ifdef LCD_8_BIT_MODE
+	GPIO_writePort(LCD_DATA_PORT, a_lcdData); /* Send the byte to the data port */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+	GPIO_FAST_SET(LCD_E, LOW); /* Disable the LCD to latch the byte */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+#else
+	LCD_writeNibble(a_lcdData >> 4);
+	_delay_us(LCD_TA_DELAY_US);
+	GPIO_FAST_SET(LCD_E, LOW); /* Disable the LCD to latch the high nibble */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+	GPIO_FAST_SET(LCD_E, HIGH); /* Enable the LCD */
+	LCD_writeNibble(a_lcdData);
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+	GPIO_FAST_SET(LCD_E, LOW); /* Disable the LCD to latch the low nibble */
+	_delay_us(LCD_TA_DELAY_US); /* Delay for timing */
+#endif
+
+	g_lcdLastWrite = Timer0_getTimestamp();
+	g_lcdBusyCounts = a_busyCounts;
+}
+
+/**
+ * @brief Writes one byte to the LCD once it is ready.
+ *
+ * In LCD_ASYNC_MODE the queued bytes are sent first, so direct writes keep their order
+ * with the queued ones. The tick only drains the queue, it stays idle once it is empty.
+ *
+ * @param a_lcdData The command or character to be written.
+ * @param a_lcdRs LOW for a command, HIGH for a character.
+ * @param a_busyCounts Timer0 clocks the LCD needs to execute this write.
+ */
+static void LCD_write(uint8 a_lcdData, uint8 a_lcdRs, uint16 a_busyCounts) {
+	while (!LCD_isReady()) {
+		/* Wait for the queue and the last write to be executed */
+	}
+	LCD_busWrite(a_lcdData, a_lcdRs, a_busyCounts);
+}
+
+#ifdef LCD_ASYNC_MODE
+/**
+ * @brief Sends the oldest queued byte once the LCD is ready, called by the Timer0 tick.
+ *
+ * The tick never reads the busy flag, whose bus cycle waits in _delay_us: at one byte per tick
+ * only a clear or home command outlasts the tick, and the time table covers it.
+ */
+static void LCD_queueProcessing(void) {
+	volatile LCD_QueueEntryType *entry;
+
+	if ((g_lcdQueueHead == g_lcdQueueTail) || !LCD_timedReady()) {
+		return;
+	}
+
+	entry = &g_lcdQueue[g_lcdQueueTail & LCD_QUEUE_MASK];
+#ifdef LCD_RW_MODE
+	if (entry->type != LCD_ENTRY_INIT) {
+		g_lcdBusyFlagValid = TRUE; /* The interface is configured, the busy flag can be read */
+	}
+#endif
+	LCD_busWrite(entry->data, (entry->type == LCD_ENTRY_DATA) ? HIGH : LOW,
+			LCD_entryCounts(entry->data, entry->type));
+	g_lcdQueueTail++; /* Free the slot only after the byte is sent */
+}
+
+/**
+ * @brief Adds a byte to the transmit queue and tracks the cursor it leaves the LCD at.
+ *
+ * @param a_lcdData The command or character to be queued.
+ * @param a_type How the byte is written.
+ * @return TRUE if the byte was queued, FALSE if the queue is full.
+ */
+static boolean LCD_enqueue(uint8 a_lcdData, LCD_EntryType a_type) {
+	uint8 head = g_lcdQueueHead;
+
+	if ((uint8) (head - g_lcdQueueTail) >= LCD_QUEUE_SIZE) {
+		return FALSE;
+	}
+
+	g_lcdQueue[head & LCD_QUEUE_MASK].data = a_lcdData;
+	g_lcdQueue[head & LCD_QUEUE_MASK].type = a_type;
+	g_lcdQueueHead = head + 1; /* Publish the entry after it is written */
+
+	if (a_type == LCD_ENTRY_DATA) {
+		g_lcdAddress++;
+	} else if (a_lcdData & LCD_SET_CURSOR_LOCATION) {
+		g_lcdAddress = a_lcdData & ~LCD_SET_CURSOR_LOCATION;
+	} else if (a_lcdData <= LCD_RETURN_HOME_COMMAND) {
+		g_lcdAddress = 0; /* Clear display and return home */
+	}
+	return TRUE;
+}
+
+/**
+ * @brief Queues a command to be sent by the Timer0 tick.
+ *
+ * @param a_lcdCommand The command to send (refer to defined command constants).
+ * @return TRUE if the command was queued, FALSE if the queue is full.
+ */
+boolean LCD_enqueueCommand(uint8 a_lcdCommand) {
+	return LCD_enqueue(a_lcdCommand, LCD_ENTRY_COMMAND);
+}
+
+/**
+ * @brief Queues a string to be displayed from the cursor position by the Timer0 tick.
+ *
+ * @param a_lcdString Pointer to the null-terminated string.
+ * @return The number of characters queued, less than the string length if the queue got full.
+ */
+uint8 LCD_enqueueString(const char *a_lcdString) {
+	uint8 count = 0;
+
+	while ((a_lcdString[count] != '\0') && LCD_enqueue(a_lcdString[count], LCD_ENTRY_DATA)) {
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Queues a string stored in flash memory to be displayed from the cursor position by the Timer0 tick.
+ *
+ * @param a_lcdString Pointer to the null-terminated string in flash memory.
+ * @return The number of characters queued, less than the string length if the queue got full.
+ */
+uint8 LCD_enqueueString_P(const char *a_lcdString) {
+	uint8 count = 0;
+	uint8 l_char = pgm_read_byte(a_lcdString);
+
+	while ((l_char != '\0') && LCD_enqueue(l_char, LCD_ENTRY_DATA)) {
+		count++;
+		l_char = pgm_read_byte(a_lcdString + count);
+	}
+	return count;
+}
+
+/**
+ * @brief Gets the number of bytes waiting in the transmit queue.
+ *
+ * @return The queue depth (0 to LCD_QUEUE_SIZE).
+ */
+uint8 LCD_getQueueDepth(void) {
+	return (uint8) (g_lcdQueueHead - g_lcdQueueTail);
+}
+#endif
+
+/**
+ * @brief Sends a command to the LCD.
+ *
+ * This function sends a command to the LCD to perform specific operations
+ * such as clearing the screen, setting display modes, or moving the cursor.
+ * It waits for the previous write, there is no fixed delay after the command.
+ *
+ * @param a_lcdCommand The command to be sent to the LCD (e.g., LCD_CLEAR_SCREEN_COMMAND).
+ */
+void LCD_sendCommand(uint8 a_lcdCommand) {
+	LCD_write(a_lcdCommand, LOW, LCD_commandCounts(a_lcdCommand));
+}
+
+/**
+ * @brief Sends a character to the LCD to be displayed at the current cursor position.
+ *
+ * This function sends a single character to the LCD for display.
+ * It sets the RS pin to 1 to indicate that the data is a character.
+ *
+ * @param a_lcdChar The ASCII character to be sent to the LCD.
+ */
+void LCD_displayChar(uint8 a_lcdChar) {
+	LCD_write(a_lcdChar, HIGH, LCD_US_TO_COUNTS(LCD_DATA_WRITE_TIME_US));
+	g_lcdAddress++; /* The LCD moved its cursor to the next cell */
+}
+
+/**
+ * @brief Writes one byte of the init sequence, queued for the Timer0 tick in LCD_ASYNC_MODE.
+ *
+ * The queue holds the whole sequence, so nothing is dropped when LCD_init() runs once at
+ * startup with an empty queue.
+ *
+ * @param a_lcdData The command or character to be written.
+ * @param a_type How the byte is written.
+ */
+static void LCD_initWrite(uint8 a_lcdData, LCD_EntryType a_type) {
+#ifdef LCD_ASYNC_MODE
+	LCD_enqueue(a_lcdData, a_type);
+#else
+	LCD_write(a_lcdData, (a_type == LCD_ENTRY_DATA) ? HIGH : LOW, LCD_entryCounts(a_lcdData, a_type));
+#endif
+}
+
+#ifdef LCD_BAR_GRAPH_MODE
+/**
+ * @brief Writes the bar graph glyphs into the CGRAM, starting at character code LCD_BAR_FIRST_GLYPH.
+ *
+ * The CGRAM address increments after every byte like the DDRAM one, so one address command
+ * covers all the glyphs. The caller moves the cursor back to the DDRAM afterwards.
+ */
+static void LCD_loadBarGlyphs(void) {
+	uint8 glyph, row;
+
+	LCD_initWrite(LCD_SET_CGRAM_ADDRESS | (LCD_BAR_FIRST_GLYPH * LCD_GLYPH_ROWS), LCD_ENTRY_COMMAND);
+	for (glyph = 0; glyph < LCD_BAR_GLYPHS; glyph++) {
+		for (row = 0; row < LCD_GLYPH_ROWS; row++) {
+			LCD_initWrite(pgm_read_byte(&g_lcdBarGlyphs[glyph][row]), LCD_ENTRY_DATA);
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Initializes the LCD in 8-bit mode with 2 display lines.
+ *
+ * This function configures the LCD by setting the appropriate modes (2-line, 8-bit),
+ * turning off the cursor, and clearing the display. It should be called once during initialization.
+ * Timer0 must already be running since the command timing is based on its timestamp.
+ *
+ * The power-up time is the execution time of a write made when Timer0 started, so it runs
+ * while the rest of the system initializes. In LCD_ASYNC_MODE the sequence is queued and this
+ * function returns at once, the Timer0 tick sends it in about 40 ms and the framebuffer can be
+ * used and flushed meanwhile, behind it in the queue.
+ */
+void LCD_init() {
+	GPIO_ARR_setPinDirection(LCD_RS, PIN_OUTPUT); /* Set RS pin as output */
+	GPIO_ARR_setPinDirection(LCD_E, PIN_OUTPUT); /* Set E pin as output */
+#ifdef LCD_RW_MODE
+	GPIO_ARR_setPinDirection(LCD_RW, PIN_OUTPUT); /* Set R/W pin as output */
+	GPIO_FAST_SET(LCD_RW, LOW); /* Write mode */
+	g_lcdBusyFlagValid = FALSE;
+#endif
+	g_lcdLastWrite = 0; /* Wait for LCD to power up, counted from the start of Timer0 */
+	g_lcdBusyCounts = LCD_US_TO_COUNTS(LCD_POWER_UP_DELAY_MS * 1000UL);
+#ifdef LCD_8_BIT_MODE
+	GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT); /* Set data port as output */
+	LCD_initWrite(LCD_TWO_LINE_EIGHT_BIT_COMMAND, LCD_ENTRY_INIT); /* Set LCD to 2 lines, 8-bit mode */
+#else
+	GPIO_ARR_setPinDirection(LCD_D4, PIN_OUTPUT);
+	GPIO_ARR_setPinDirection(LCD_D5, PIN_OUTPUT);
+	GPIO_ARR_setPinDirection(LCD_D6, PIN_OUTPUT);
+	GPIO_ARR_setPinDirection(LCD_D7, PIN_OUTPUT);
+	/* Send for 4 bit initialization of LCD  */
+	LCD_initWrite(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1, LCD_ENTRY_INIT);
+	LCD_initWrite(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2, LCD_ENTRY_INIT);
+
+	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
+	LCD_initWrite(LCD_TWO_LINES_FOUR_BITS_MODE, LCD_ENTRY_INIT);
+#endif
+#if defined(LCD_RW_MODE) && !defined(LCD_ASYNC_MODE)
+	g_lcdBusyFlagValid = TRUE; /* The interface is configured, the busy flag can be read */
+#endif
+
+	LCD_initWrite(LCD_CURSOR_OFF_COMMAND, LCD_ENTRY_COMMAND); /* Turn off cursor */
+	LCD_initWrite(LCD_CLEAR_SCREEN_COMMAND, LCD_ENTRY_COMMAND); /* Clear the LCD screen */
+#ifdef LCD_BAR_GRAPH_MODE
+	LCD_loadBarGlyphs(); /* Loaded once, the CGRAM keeps them until power off */
+#endif
+	LCD_bufferReset(); /* The framebuffer now matches the blank screen */
+
+	/* Also points the address counter back to the DDRAM */
+	LCD_initWrite(LCD_cellAddress(0, 0) | LCD_SET_CURSOR_LOCATION, LCD_ENTRY_COMMAND);
+	g_lcdAddress = LCD_cellAddress(0, 0);
+
+#ifdef LCD_ASYNC_MODE
+	if (!g_lcdQueueStarted) {
+		g_lcdQueueStarted = Timer0_addCallBack(LCD_queueProcessing);
+	}
+#endif
+}
+
+/**
+ * @brief Displays a string on the LCD starting from the current cursor position.
+ *
+ * This function sends a null-terminated string to the LCD. The string is displayed starting
+ * at the current cursor location. The function will not display more than the maximum number
+ * of columns allowed by the LCD.
+ *
+ * @param a_lcdString Pointer to the null-terminated string to be displayed.
+ * @return LCD_ERROR Returns SUCSSES if the string fits within the display, otherwise returns EXCEEDMAXCOLUMNS.
+ */
+uint8 LCD_displayString(const char *a_lcdString) {
+	int i = 0;
+	while (a_lcdString[i] != '\0') {
+		LCD_displayChar(a_lcdString[i]); /* Send each character in the string */
+		if (i == LCD_MAX_COLUMNS_INDEX) /* Stop if maximum column index is reached */
+			break;
+		i++;
+	}
+	return i < LCD_COLUMNS ? SUCSSES : EXCEEDMAXCOLUMNS; /* Return appropriate status */
+}
+
+/**
+ * @brief Displays a string stored in flash memory starting from the current cursor position.
+ *
+ * The characters are read one by one from the flash, the string never takes RAM.
+ *
+ * @param a_lcdString Pointer to the null-terminated string in flash memory (PSTR or PROGMEM).
+ * @return LCD_ERROR Returns SUCSSES if the string fits within the display, otherwise returns EXCEEDMAXCOLUMNS.
+ */
+uint8 LCD_displayString_P(const char *a_lcdString) {
+	uint8 i = 0;
+	uint8 l_char = pgm_read_byte(a_lcdString);
+
+	while (l_char != '\0') {
+		LCD_displayChar(l_char);
+		if (i == LCD_MAX_COLUMNS_INDEX) /* Stop if maximum column index is reached */
+			break;
+		i++;
+		l_char = pgm_read_byte(a_lcdString + i);
+	}
+	return i < LCD_COLUMNS ? SUCSSES : EXCEEDMAXCOLUMNS;
+}
+
+/**
+ * @brief Moves the LCD cursor to a specific position.
+ *
+ * This function moves the cursor to the specified row and column on the LCD.
+ * It calculates the appropriate memory address in the LCD and sends the cursor
+ * position command.
+ *
+ * @param a_lcdRow The row to move the cursor to (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to move the cursor to (0 to LCD_MAX_COLUMNS_INDEX).
+ */
+void LCD_moveCursor(uint8 a_lcdRow, uint8 a_lcdCol) {
+	g_lcdAddress = LCD_cellAddress(a_lcdRow, a_lcdCol);
+
+	/* Move the LCD cursor to this specific address */
+	LCD_sendCommand(g_lcdAddress | LCD_SET_CURSOR_LOCATION);
+}
+
+/**
+ * @brief Displays a string starting at a specified row and column on the LCD.
+ *
+ * This function moves the cursor to the given row and column, then displays the provided string.
+ *
+ * @param row The row to start displaying the string (0 to LCD_ROWS-1).
+ * @param col The column to start displaying the string (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param Str Pointer to the null-terminated string to be displayed.
+ */
+void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str) {
+	LCD_moveCursor(row, col); /* Move to specified row and column */
+	LCD_displayString(Str); /* Display the string at the new cursor location */
+}
+
+/**
+ * @brief Displays a string stored in flash memory starting at a specified row and column on the LCD.
+ *
+ * @param a_lcdRow The row to start displaying the string (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start displaying the string (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string in flash memory.
+ */
+void LCD_displayStringRowColumn_P(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString) {
+	LCD_moveCursor(a_lcdRow, a_lcdCol);
+	LCD_displayString_P(a_lcdString);
+}
+
+/**
+ * @brief Displays an integer on the LCD.
+ *
+ * The digits are sent as they are found, most significant first, without leading zeros
+ * and without an intermediate string.
+ *
+ * @param data The integer value to be displayed.
+ */
+void LCD_intgerToString(int data) {
+	uint16 l_value = (uint16) data;
+	uint8 i = 0;
+
+	if (data < 0) {
+		LCD_displayChar('-');
+		l_value = (uint16) -data;
+	}
+	while ((i < LCD_MAX_DIGITS - 1) && (l_value < pgm_read_word(&g_lcdPowersOfTen[i]))) {
+		i++; /* Skip the leading zeros, the last digit is always shown */
+	}
+	for (; i < LCD_MAX_DIGITS; i++) {
+		LCD_displayChar(LCD_nextDigit(&l_value, i));
+	}
+}
+
+/**
+ * @brief Clears the entire LCD display.
+ *
+ * This function sends the clear screen command to the LCD, clearing all the displayed
+ * characters and resetting the cursor to the home position.
+ */
+void LCD_clearScreen(void) {
+	LCD_sendCommand(LCD_CLEAR_SCREEN_COMMAND); /* Send clear display command */
+	LCD_bufferReset(); /* The framebuffer now matches the blank screen */
+}
+
+/**
+ * @brief Writes a character into the framebuffer.
+ *
+ * The cell is only marked dirty when its content changes, so rewriting the same content
+ * costs no LCD traffic at the next flush.
+ *
+ * @param a_lcdRow The row of the cell (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column of the cell (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdChar The ASCII character to store.
+ */
+void LCD_bufferChar(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_lcdChar) {
+	if (a_lcdRow >= LCD_ROWS || a_lcdCol >= LCD_COLUMNS) {
+		return; /* Outside the display */
+	}
+	if (g_lcdFrame[a_lcdRow][a_lcdCol] != a_lcdChar) {
+		g_lcdFrame[a_lcdRow][a_lcdCol] = a_lcdChar;
+		SET_BIT(g_lcdDirty[a_lcdRow][a_lcdCol >> 3], (a_lcdCol & 0x07));
+	}
+}
+
+/**
+ * @brief Writes a string into the framebuffer, clipped at the end of the row.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string.
+ * @return The column following the last character written.
+ */
+uint8 LCD_bufferString(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString) {
+	while (*a_lcdString != '\0' && a_lcdCol < LCD_COLUMNS) {
+		LCD_bufferChar(a_lcdRow, a_lcdCol, *a_lcdString);
+		a_lcdString++;
+		a_lcdCol++;
+	}
+	return a_lcdCol;
+}
+
+/**
+ * @brief Writes a string stored in flash memory into the framebuffer, clipped at the end of the row.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string in flash memory.
+ * @return The column following the last character written.
+ */
+uint8 LCD_bufferString_P(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString) {
+	uint8 l_char = pgm_read_byte(a_lcdString);
+
+	while (l_char != '\0' && a_lcdCol < LCD_COLUMNS) {
+		LCD_bufferChar(a_lcdRow, a_lcdCol, l_char);
+		a_lcdString++;
+		a_lcdCol++;
+		l_char = pgm_read_byte(a_lcdString);
+	}
+	return a_lcdCol;
+}
+
+/**
+ * @brief Writes the decimal representation of an integer into the framebuffer.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_value The value to display.
+ * @return The column following the last digit written.
+ */
+uint8 LCD_bufferInteger(uint8 a_lcdRow, uint8 a_lcdCol, uint16 a_value) {
+	uint8 i = 0;
+
+	while ((i < LCD_MAX_DIGITS - 1) && (a_value < pgm_read_word(&g_lcdPowersOfTen[i]))) {
+		i++; /* Skip the leading zeros, the last digit is always shown */
+	}
+	for (; i < LCD_MAX_DIGITS; i++) {
+		LCD_bufferChar(a_lcdRow, a_lcdCol, LCD_nextDigit(&a_value, i));
+		a_lcdCol++;
+	}
+	return a_lcdCol;
+}
+
+/**
+ * @brief Writes an integer right aligned in a fixed number of cells of the framebuffer.
+ *
+ * The field always covers the same cells, so a shorter value needs no erase and only the
+ * digits that changed are sent by the next flush.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_value The value to display.
+ * @param a_width Number of cells of the field (1 to LCD_COLUMNS).
+ * @return The column following the field.
+ */
+uint8 LCD_bufferNumber(uint8 a_lcdRow, uint8 a_lcdCol, uint16 a_value, uint8 a_width) {
+	uint8 i = 0;
+	uint8 l_char;
+	boolean l_leading = TRUE;
+
+	/* Cells beyond the five digits of a uint16 are always blank */
+	while (a_width > LCD_MAX_DIGITS) {
+		LCD_bufferChar(a_lcdRow, a_lcdCol++, LCD_BLANK_CHAR);
+		a_width--;
+	}
+	i = LCD_MAX_DIGITS - a_width;
+
+	if ((i > 0) && (a_value >= pgm_read_word(&g_lcdPowersOfTen[i - 1]))) {
+		/* Too many digits for the field */
+		while (a_width > 0) {
+			LCD_bufferChar(a_lcdRow, a_lcdCol++, LCD_NUMBER_OVERFLOW_CHAR);
+			a_width--;
+		}
+		return a_lcdCol;
+	}
+
+	for (; i < LCD_MAX_DIGITS; i++) {
+		l_char = LCD_nextDigit(&a_value, i);
+		if (l_leading && (l_char == '0') && (i < LCD_MAX_DIGITS - 1)) {
+			l_char = LCD_BLANK_CHAR;
+		} else {
+			l_leading = FALSE;
+		}
+		LCD_bufferChar(a_lcdRow, a_lcdCol++, l_char);
+	}
+	return a_lcdCol;
+}
+
+#ifdef LCD_BAR_GRAPH_MODE
+/**
+ * @brief Writes a horizontal bar graph into the framebuffer.
+ *
+ * Every cell goes through LCD_bufferChar(), which marks only the changed cells dirty.
+ *
+ * @param a_lcdRow The row of the bar (0 to LCD_ROWS-1).
+ * @param a_lcdCol The first column of the bar (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_width Number of cells of the bar, clipped at the end of the row.
+ * @param a_level Lit steps, 0 to a_width * LCD_BAR_STEPS_PER_CELL.
+ */
+void LCD_bufferBar(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_width, uint8 a_level) {
+	uint8 l_char;
+
+	while ((a_width > 0) && (a_lcdCol < LCD_COLUMNS)) {
+		if (a_level >= LCD_BAR_STEPS_PER_CELL) {
+			l_char = LCD_BAR_FULL_CHAR;
+			a_level -= LCD_BAR_STEPS_PER_CELL;
+		} else if (a_level > 0) {
+			l_char = LCD_BAR_FIRST_GLYPH + a_level - 1;
+			a_level = 0;
+		} else {
+			l_char = LCD_BLANK_CHAR;
+		}
+		LCD_bufferChar(a_lcdRow, a_lcdCol, l_char);
+		a_lcdCol++;
+		a_width--;
+	}
+}
+#endif
+
+/**
+ * @brief Fills the framebuffer from a column to the end of the row.
+ *
+ * @param a_lcdRow The row to fill (0 to LCD_ROWS-1).
+ * @param a_lcdCol The first column to fill (0 to LCD_COLUMNS, LCD_COLUMNS fills nothing).
+ * @param a_lcdChar The ASCII character to fill with.
+ */
+void LCD_bufferFill(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_lcdChar) {
+	while (a_lcdCol < LCD_COLUMNS) {
+		LCD_bufferChar(a_lcdRow, a_lcdCol, a_lcdChar);
+		a_lcdCol++;
+	}
+}
+
+/**
+ * @brief Marks every framebuffer cell dirty.
+ */
+void LCD_bufferInvalidate(void) {
+	uint8 row, i;
+
+	for (row = 0; row < LCD_ROWS; row++) {
+		for (i = 0; i < LCD_DIRTY_BYTES; i++) {
+			g_lcdDirty[row][i] = 0xFF;
+		}
+	}
+}
+
+/**
+ * @brief Sends one framebuffer character for LCD_flush(), queued in LCD_ASYNC_MODE.
+ *
+ * @param a_lcdChar The ASCII character to send.
+ */
+static void LCD_flushChar(uint8 a_lcdChar) {
+#ifdef LCD_ASYNC_MODE
+	LCD_enqueue(a_lcdChar, LCD_ENTRY_DATA);
+#else
+	LCD_displayChar(a_lcdChar);
+#endif
+}
+
+/**
+ * @brief Moves the cursor for LCD_flush(), queued in LCD_ASYNC_MODE.
+ *
+ * @param a_address The DDRAM address to move the cursor to.
+ */
+static void LCD_flushCursor(uint8 a_address) {
+#ifdef LCD_ASYNC_MODE
+	LCD_enqueue(a_address | LCD_SET_CURSOR_LOCATION, LCD_ENTRY_COMMAND);
+#else
+	g_lcdAddress = a_address;
+	LCD_sendCommand(a_address | LCD_SET_CURSOR_LOCATION);
+#endif
+}
+
+/**
+ * @brief Sends the dirty framebuffer cells to the LCD.
+ *
+ * The LCD increments its cursor after every character, so consecutive dirty cells need a
+ * single LCD_moveCursor(). A run of up to LCD_FLUSH_MAX_GAP clean cells between two dirty
+ * runs is rewritten instead of sending a new cursor command.
+ *
+ * @return TRUE if no cell is left dirty, FALSE if the queue got full first.
+ */
+boolean LCD_flush(void) {
+	uint8 row, col, address, gapCol;
+
+	for (row = 0; row < LCD_ROWS; row++) {
+		for (col = 0; col < LCD_COLUMNS; col++) {
+			if (g_lcdDirty[row][col >> 3] == 0) {
+				col |= 0x07; /* Skip the remaining cells of a clean group of eight */
+				continue;
+			}
+			if (BIT_IS_CLEAR(g_lcdDirty[row][col >> 3], (col & 0x07))) {
+				continue;
+			}
+#ifdef LCD_ASYNC_MODE
+			if ((LCD_QUEUE_SIZE - LCD_getQueueDepth()) < (LCD_FLUSH_MAX_GAP + 2)) {
+				return FALSE; /* No room for a cursor command, a gap and the cell, retry at the next flush */
+			}
+#endif
+
+			address = LCD_cellAddress(row, col);
+			if (address != g_lcdAddress) {
+				if (address > g_lcdAddress && (address - g_lcdAddress) <= LCD_FLUSH_MAX_GAP
+						&& col >= (address - g_lcdAddress)) {
+					/* Bridge the short clean gap on this row, it is as cheap as moving the cursor */
+					for (gapCol = col - (address - g_lcdAddress); gapCol < col; gapCol++) {
+						LCD_flushChar(g_lcdFrame[row][gapCol]);
+					}
+				} else {
+					LCD_flushCursor(address);
+				}
+			}
+			LCD_flushChar(g_lcdFrame[row][col]);
+			CLEAR_BIT(g_lcdDirty[row][col >> 3], (col & 0x07));
+		}
+	}
+	return TRUE;
+}
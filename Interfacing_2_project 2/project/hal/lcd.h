@@ -1,195 +1,487 @@
-/**
- * @file lcd.h
- * @brief LCD Hardware Abstraction Layer (HAL) interface.
- *
- * This file provides the declarations for interfacing with a 2x16 character LCD
- * display using a microcontroller. It includes definitions for LCD control pins,
- * various LCD commands, and essential functions for sending data and commands to the LCD.
- *
- * @date 27 Sept 2024
- * @author Ibrahim Mohsen
- */
-
-#ifndef LCD_H_
-#define LCD_H_
-
-#include "../common/std_types.h"
-
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-/**
- *  @brief LCD configuration either 8 bit or 4 bit .
- *  if 8 bit uncomment the macro definition below if 4 bit leave it as is
- *
-#define LCD_8_BIT_MODE
-**/
-
-/**
- * @brief GPIO pin connected to the Register Select (RS) pin of the LCD.
- *
- * The RS pin selects between sending commands (RS=0) and data (RS=1) to the LCD.
- */
-#define LCD_RS GPIO_PA1
-
-/**
- * @brief GPIO pin connected to the Enable (E) pin of the LCD.
- *
- * The E pin is used to latch data on the data pins when transitioning from high to low.
- */
-#define LCD_E   GPIO_PA2
-#ifdef LCD_8_BIT_MODE
-/**
- * @brief The ID of the GPIO port used for data transmission to the LCD.
- *
- * This should correspond to the microcontroller port where the LCD's data lines (D0-D7) are connected.
- */
-
-#define LCD_DATA_PORT PORTC_ID
-#else
-/**
- * @brief The ID of the GPIO pins used for data transmission to the LCD.
- *
- * This should correspond to the microcontroller pins where the LCD's data lines (D4-D7) are connected.
- */
-#define LCD_D4 GPIO_PA3
-#define LCD_D5 GPIO_PA4
-#define LCD_D6 GPIO_PA5
-#define LCD_D7 GPIO_PA6
-#endif
-/**
- * @brief Delay in microseconds for the TA (Enable) signal timing.
- *
- * A small delay is required between setting the Enable pin high and low to latch data/commands.
- */
-#define LCD_TA_DELAY_US 1
-
-/**
- * @brief Command to configure the LCD for 2 lines and 8-bit data mode.
- */
-#define LCD_TWO_LINE_EIGHT_BIT_COMMAND 0x38
-/**
- * @brief Command to configure the LCD for 2 lines and 4-bit data mode.
- */
-#define LCD_TWO_LINES_FOUR_BITS_MODE         0x28
-/**
- * @brief Commands to init the LCD for 2 lines and 4-bit data mode.
- */
-#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT1   0x33
-#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT2   0x32
-
-
-/**
- * @brief Command to turn off the LCD cursor.
- */
-#define LCD_CURSOR_OFF_COMMAND 0x0c
-
-/**
- * @brief Command to clear the entire LCD display.
- */
-#define LCD_CLEAR_SCREEN_COMMAND 0x01
-
-/**
- * @brief Number of display rows on the LCD.
- */
-#define LCD_ROWS 2
-
-/**
- * @brief Number of character columns on the LCD.
- */
-#define LCD_COLUMNS 16
-
-/**
- * @brief Maximum column index for the LCD.
- *
- * Since columns are indexed from 0, the maximum index is 15 for a 16-column display.
- */
-#define LCD_MAX_COLUMNS_INDEX 15
-
-/**
- * @brief Command to set the cursor location.
- *
- * This command is used in combination with row/column offsets to move the cursor to a specific position.
- */
-#define LCD_SET_CURSOR_LOCATION 0x80
-
-/**
- * @brief Memory offset for the first row of the LCD.
- *
- * This value is used to calculate cursor positions for the first row.
- */
-#define LCD_ROW_1_OFFSET 0x40
-
-/**
- * @brief Memory offset for the second row of the LCD.
- *
- * This value is used to calculate cursor positions for the second row.
- */
-#define LCD_ROW_2_OFFSET 0x10
-
-/**
- * @brief Memory offset for the third row of the LCD (if applicable for larger displays).
- */
-#define LCD_ROW_3_OFFSET 0x50
-
-/*******************************************************************************
- *                               Function Prototypes                           *
- *******************************************************************************/
-
-/**
- * @brief Sends a character to the LCD to be displayed at the current cursor position.
- *
- * @param data The character to send (ASCII value).
- */
-void LCD_displayChar(uint8 data);
-
-/**
- * @brief Sends a command to the LCD.
- *
- * Commands are used to configure the LCD (e.g., clear the screen, set cursor position).
- *
- * @param command The command to send (refer to defined command constants).
- */
-void LCD_sendCommand(uint8 command);
-
-/**
- * @brief Initializes the LCD in 8-bit mode with 2 display lines.
- *
- * This function should be called during system initialization to configure the LCD.
- */
-void LCD_init();
-
-/**
- * @brief Displays a string on the LCD starting from the current cursor position.
- *
- * @param str Pointer to a null-terminated string to be displayed on the LCD.
- * @return LCD_ERROR Indicates if the string exceeds the maximum column limit (returns EXCEEDMAXCOLUMNS) or success (returns SUCCESS).
- */
-uint8 LCD_displayString(const char* str);
-
-/**
- * @brief Moves the LCD cursor to a specific position.
- *
- * The cursor is moved to the given row and column.
- *
- * @param a_lcdRow The row number (0 or 1).
- * @param a_lcdCol The column number (0 to 15).
- */
-void LCD_moveCursor(uint8 a_lcdRow, uint8 a_lcdCol);
-void LCD_intgerToString( int);
-/*******************************************************************************
- *                               Data Types                                    *
- *******************************************************************************/
-
-/**
- * @enum LCD_ERROR
- * @brief Defines possible error codes for LCD operations.
- *
- * These error codes are used to signal whether a certain operation was successful or if an issue occurred (e.g., exceeding column limits).
- */
-typedef enum {
-    SUCSSES,         /**< Indicates successful completion of an operation. */
-    EXCEEDMAXCOLUMNS /**< Indicates that the operation exceeded the maximum column limit of the LCD. */
-} LCD_ERROR;
-void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str);
-#endif /* LCD_H_ */
+/**
+ * @file lcd.h
+ * @brief LCD Hardware Abstraction Layer (HAL) interface.
+ *
+ * This file provides the declarations for interfacing with a 2x16 character LCD
+ * display using a microcontroller. It includes definitions for LCD control pins,
+ * various LCD commands, and essential functions for sending data and commands to the LCD.
+ *
+ * @date 27 Sept 2024
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/**
+ *  @brief LCD configuration either 8 bit or 4 bit .
+ *  if 8 bit uncomment the macro definition below if 4 bit leave it as is
+ *
+#define LCD_8_BIT_MODE
+**/
+
+/**
+ * @brief GPIO pin connected to the Register Select (RS) pin of the LCD.
+ *
+ * The RS pin selects between sending commands (RS=0) and data (RS=1) to the LCD.
+ */
+#define LCD_RS GPIO_PA1
+
+/**
+ * @brief GPIO pin connected to the Enable (E) pin of the LCD.
+ *
+ * The E pin is used to latch data on the data pins when transitioning from high to low.
+ */
+#define LCD_E   GPIO_PA2
+
+/**
+ *  @brief LCD busy flag mode.
+ *  if the LCD R/W pin is wired to LCD_RW uncomment the macro definition below, the driver then
+ *  polls the busy flag (DB7) before every write from the caller. If R/W is tied to ground leave it
+ *  as is and the driver enforces the minimum execution time of every command through Timer0
+ *  timestamps. The queue of LCD_ASYNC_MODE always uses the timestamps, so the Timer0 tick never
+ *  reads the bus.
+ *
+#define LCD_RW_MODE
+**/
+
+/**
+ *  @brief LCD transmit mode.
+ *  LCD_flush() and the LCD_enqueue functions hand their bytes to a queue drained by the Timer0 tick,
+ *  one byte per tick once the LCD is ready. Comment the macro definition below to have LCD_flush()
+ *  write the bytes blocking from the caller instead.
+ */
+#define LCD_ASYNC_MODE
+
+/**
+ *  @brief LCD bar graph mode.
+ *  LCD_init() loads the partial cell glyphs used by LCD_bufferBar() into the CGRAM, comment the
+ *  macro definition below to leave the CGRAM unused.
+ */
+#define LCD_BAR_GRAPH_MODE
+
+#ifdef LCD_RW_MODE
+/**
+ * @brief GPIO pin connected to the Read/Write (R/W) pin of the LCD.
+ *
+ * The R/W pin selects between writing to the LCD (R/W=0) and reading its busy flag (R/W=1).
+ */
+#define LCD_RW  GPIO_PA0
+#endif
+
+#ifdef LCD_8_BIT_MODE
+/**
+ * @brief The ID of the GPIO port used for data transmission to the LCD.
+ *
+ * This should correspond to the microcontroller port where the LCD's data lines (D0-D7) are connected.
+ */
+
+#define LCD_DATA_PORT PORTC_ID
+#else
+/**
+ * @brief The ID of the GPIO pins used for data transmission to the LCD.
+ *
+ * This should correspond to the microcontroller pins where the LCD's data lines (D4-D7) are connected.
+ */
+#define LCD_D4 GPIO_PA3
+#define LCD_D5 GPIO_PA4
+#define LCD_D6 GPIO_PA5
+#define LCD_D7 GPIO_PA6
+#endif
+/**
+ * @brief Delay in microseconds for the TA (Enable) signal timing.
+ *
+ * A small delay is required between setting the Enable pin high and low to latch data/commands.
+ */
+#define LCD_TA_DELAY_US 1
+
+/**
+ * @brief Power up time of the LCD controller before the first command in milliseconds.
+ *
+ * Counted from the start of Timer0, the first step of the initialization.
+ */
+#define LCD_POWER_UP_DELAY_MS 20
+
+/**
+ * @brief Minimum execution times of the LCD controller in microseconds (HD44780 datasheet, 270 KHz).
+ *
+ * Clear and return home are the slow commands, the init commands also cover the 4.1 ms the
+ * controller needs while the interface is being switched.
+ */
+#define LCD_CLEAR_HOME_TIME_US   1520
+#define LCD_COMMAND_TIME_US      37
+#define LCD_DATA_WRITE_TIME_US   41
+#define LCD_INIT_COMMAND_TIME_US 4100
+
+/**
+ * @brief Microseconds per Timer0 clock, Timer0 must run on the F_CPU/64 clock used by the scheduler.
+ */
+#define LCD_TIMER0_COUNT_US (64000000UL / F_CPU)
+
+/**
+ * @brief Converts a time in microseconds to Timer0 clocks rounded up.
+ */
+#define LCD_US_TO_COUNTS(us) (((us) + LCD_TIMER0_COUNT_US - 1) / LCD_TIMER0_COUNT_US)
+
+/**
+ * @brief Command to configure the LCD for 2 lines and 8-bit data mode.
+ */
+#define LCD_TWO_LINE_EIGHT_BIT_COMMAND 0x38
+/**
+ * @brief Command to configure the LCD for 2 lines and 4-bit data mode.
+ */
+#define LCD_TWO_LINES_FOUR_BITS_MODE         0x28
+/**
+ * @brief Commands to init the LCD for 2 lines and 4-bit data mode.
+ */
+#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT1   0x33
+#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT2   0x32
+
+
+/**
+ * @brief Command to turn off the LCD cursor.
+ */
+#define LCD_CURSOR_OFF_COMMAND 0x0c
+
+/**
+ * @brief Command to clear the entire LCD display.
+ */
+#define LCD_CLEAR_SCREEN_COMMAND 0x01
+
+/**
+ * @brief Command to return the cursor to the home position.
+ */
+#define LCD_RETURN_HOME_COMMAND 0x02
+
+/**
+ * @brief Command to set the CGRAM address, the glyph of character code n starts at address n * 8.
+ */
+#define LCD_SET_CGRAM_ADDRESS 0x40
+
+/**
+ * @brief Number of pixel rows of a character glyph in the CGRAM (5x8 dots).
+ */
+#define LCD_GLYPH_ROWS 8
+
+/**
+ * @brief Number of display rows on the LCD.
+ */
+#define LCD_ROWS 2
+
+/**
+ * @brief Number of character columns on the LCD.
+ */
+#define LCD_COLUMNS 16
+
+/**
+ * @brief Maximum column index for the LCD.
+ *
+ * Since columns are indexed from 0, the maximum index is 15 for a 16-column display.
+ */
+#define LCD_MAX_COLUMNS_INDEX 15
+
+/**
+ * @brief Command to set the cursor location.
+ *
+ * This command is used in combination with row/column offsets to move the cursor to a specific position.
+ */
+#define LCD_SET_CURSOR_LOCATION 0x80
+
+/**
+ * @brief Memory offset for the first row of the LCD.
+ *
+ * This value is used to calculate cursor positions for the first row.
+ */
+#define LCD_ROW_1_OFFSET 0x40
+
+/**
+ * @brief Memory offset for the second row of the LCD.
+ *
+ * This value is used to calculate cursor positions for the second row.
+ */
+#define LCD_ROW_2_OFFSET 0x10
+
+/**
+ * @brief Memory offset for the third row of the LCD (if applicable for larger displays).
+ */
+#define LCD_ROW_3_OFFSET 0x50
+
+/**
+ * @brief Character held by the framebuffer cells of a cleared display.
+ */
+#define LCD_BLANK_CHAR ' '
+
+/**
+ * @brief Character filling a LCD_bufferNumber() field too narrow for its value.
+ */
+#define LCD_NUMBER_OVERFLOW_CHAR '-'
+
+/**
+ * @brief Largest run of clean cells that LCD_flush() rewrites instead of moving the cursor.
+ *
+ * Rewriting one cell costs the same bus transfer as one cursor command, so bridging a single
+ * clean cell between two dirty runs saves a LCD_moveCursor() at no extra cost.
+ */
+#define LCD_FLUSH_MAX_GAP 1
+
+#ifdef LCD_BAR_GRAPH_MODE
+/**
+ * @brief Bar graph steps per cell, one per pixel column of the 5x8 character.
+ */
+#define LCD_BAR_STEPS_PER_CELL 5
+
+/**
+ * @brief Character code of the glyph with one lit column, codes up to
+ * LCD_BAR_FIRST_GLYPH + LCD_BAR_STEPS_PER_CELL - 2 light one more column each.
+ *
+ * Code 0 is left unused so glyphs never end a string.
+ */
+#define LCD_BAR_FIRST_GLYPH 1
+
+/**
+ * @brief Character of a full bar cell, the all dots block of the HD44780 character ROM.
+ */
+#define LCD_BAR_FULL_CHAR 0xFF
+#endif
+
+#ifdef LCD_ASYNC_MODE
+/**
+ * @brief Number of bytes the transmit queue holds, must be a power of two not above 128.
+ *
+ * A full refresh of a 2x16 display needs 2 cursor commands and 32 characters.
+ */
+#define LCD_QUEUE_SIZE 64
+#endif
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Sends a character to the LCD to be displayed at the current cursor position.
+ *
+ * @param data The character to send (ASCII value).
+ */
+void LCD_displayChar(uint8 data);
+
+/**
+ * @brief Sends a command to the LCD.
+ *
+ * Commands are used to configure the LCD (e.g., clear the screen, set cursor position).
+ *
+ * @param command The command to send (refer to defined command constants).
+ */
+void LCD_sendCommand(uint8 command);
+
+/**
+ * @brief Initializes the LCD in 8-bit mode with 2 display lines.
+ *
+ * This function should be called during system initialization to configure the LCD.
+ * In LCD_BAR_GRAPH_MODE it also loads the bar graph glyphs into the CGRAM.
+ * Timer0 must already be running (Scheduler_init) since the command timing is based on its timestamp.
+ * In LCD_ASYNC_MODE the power-up wait and the init sequence are queued for the Timer0 tick and it
+ * returns at once, LCD_isReady() turns TRUE once they are sent.
+ */
+void LCD_init();
+
+/**
+ * @brief Checks if the LCD can accept the next command or character.
+ *
+ * In LCD_RW_MODE the busy flag is read, otherwise the minimum execution time of the last
+ * write is compared against the Timer0 timestamp. Writes wait for this internally, callers
+ * may poll it to do other work instead of blocking. In LCD_ASYNC_MODE the transmit queue
+ * must also be empty.
+ *
+ * @return TRUE if the LCD is ready, FALSE while it is still executing the last write.
+ */
+boolean LCD_isReady(void);
+
+/**
+ * @brief Displays a string on the LCD starting from the current cursor position.
+ *
+ * @param str Pointer to a null-terminated string to be displayed on the LCD.
+ * @return LCD_ERROR Indicates if the string exceeds the maximum column limit (returns EXCEEDMAXCOLUMNS) or success (returns SUCCESS).
+ */
+uint8 LCD_displayString(const char* str);
+
+/**
+ * @brief Displays a string stored in flash memory starting from the current cursor position.
+ *
+ * @param a_lcdString Pointer to the null-terminated string in flash memory (PSTR or PROGMEM).
+ * @return LCD_ERROR Indicates if the string exceeds the maximum column limit (returns EXCEEDMAXCOLUMNS) or success (returns SUCCESS).
+ */
+uint8 LCD_displayString_P(const char *a_lcdString);
+
+/**
+ * @brief Moves the LCD cursor to a specific position.
+ *
+ * The cursor is moved to the given row and column.
+ *
+ * @param a_lcdRow The row number (0 or 1).
+ * @param a_lcdCol The column number (0 to 15).
+ */
+void LCD_moveCursor(uint8 a_lcdRow, uint8 a_lcdCol);
+void LCD_intgerToString( int);
+
+/**
+ * @brief Clears the entire LCD display and the framebuffer.
+ */
+void LCD_clearScreen(void);
+
+/**
+ * @brief Writes a character into the framebuffer.
+ *
+ * The cell is only marked dirty when its content changes, nothing is sent to the LCD until
+ * LCD_flush() is called. Writes outside the display are ignored.
+ *
+ * @param a_lcdRow The row of the cell (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column of the cell (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdChar The ASCII character to store.
+ */
+void LCD_bufferChar(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_lcdChar);
+
+/**
+ * @brief Writes a string into the framebuffer, clipped at the end of the row.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string.
+ * @return The column following the last character written.
+ */
+uint8 LCD_bufferString(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString);
+
+/**
+ * @brief Writes a string stored in flash memory into the framebuffer, clipped at the end of the row.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string in flash memory (PSTR or PROGMEM).
+ * @return The column following the last character written.
+ */
+uint8 LCD_bufferString_P(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString);
+
+/**
+ * @brief Writes the decimal representation of an integer into the framebuffer.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_value The value to display.
+ * @return The column following the last digit written.
+ */
+uint8 LCD_bufferInteger(uint8 a_lcdRow, uint8 a_lcdCol, uint16 a_value);
+
+/**
+ * @brief Writes an integer right aligned in a fixed number of cells of the framebuffer.
+ *
+ * The digits are written straight into the cells, without an intermediate string or division.
+ * Leading zeros are blank, a value with more digits than the field fills it with
+ * LCD_NUMBER_OVERFLOW_CHAR.
+ *
+ * @param a_lcdRow The row to start at (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column to start at (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_value The value to display.
+ * @param a_width Number of cells of the field (1 to LCD_COLUMNS).
+ * @return The column following the field.
+ */
+uint8 LCD_bufferNumber(uint8 a_lcdRow, uint8 a_lcdCol, uint16 a_value, uint8 a_width);
+
+#ifdef LCD_BAR_GRAPH_MODE
+/**
+ * @brief Writes a horizontal bar graph into the framebuffer.
+ *
+ * The bar grows from the left with one step per pixel column, cells left of the end are full,
+ * the end cell shows a partial glyph and the cells right of it are blank. Only the cells around
+ * the previous and new end positions change, so the next LCD_flush() sends them alone.
+ *
+ * @param a_lcdRow The row of the bar (0 to LCD_ROWS-1).
+ * @param a_lcdCol The first column of the bar (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_width Number of cells of the bar, clipped at the end of the row.
+ * @param a_level Lit steps, 0 to a_width * LCD_BAR_STEPS_PER_CELL (larger values show a full bar).
+ */
+void LCD_bufferBar(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_width, uint8 a_level);
+#endif
+
+/**
+ * @brief Fills the framebuffer from a column to the end of the row.
+ *
+ * Used to erase what remains of a longer previous content.
+ *
+ * @param a_lcdRow The row to fill (0 to LCD_ROWS-1).
+ * @param a_lcdCol The first column to fill (0 to LCD_COLUMNS, LCD_COLUMNS fills nothing).
+ * @param a_lcdChar The ASCII character to fill with.
+ */
+void LCD_bufferFill(uint8 a_lcdRow, uint8 a_lcdCol, uint8 a_lcdChar);
+
+/**
+ * @brief Marks every framebuffer cell dirty.
+ *
+ * Should be called after the display was written directly with LCD_displayChar() or
+ * LCD_displayString(), so the next LCD_flush() restores the framebuffer content.
+ */
+void LCD_bufferInvalidate(void);
+
+/**
+ * @brief Sends the dirty framebuffer cells to the LCD.
+ *
+ * Only the changed runs are sent, using as few LCD_moveCursor() commands as possible.
+ * When nothing changed since the previous flush, nothing is sent.
+ * In LCD_ASYNC_MODE the cells are queued, a full queue leaves the rest dirty for the next flush.
+ *
+ * @return TRUE if no cell is left dirty, the LCD shows the framebuffer once LCD_isReady().
+ */
+boolean LCD_flush(void);
+
+#ifdef LCD_ASYNC_MODE
+/**
+ * @brief Queues a command to be sent by the Timer0 tick.
+ *
+ * @param a_lcdCommand The command to send (refer to defined command constants).
+ * @return TRUE if the command was queued, FALSE if the queue is full.
+ */
+boolean LCD_enqueueCommand(uint8 a_lcdCommand);
+
+/**
+ * @brief Queues a string to be displayed from the cursor position by the Timer0 tick.
+ *
+ * @param a_lcdString Pointer to the null-terminated string.
+ * @return The number of characters queued, less than the string length if the queue got full.
+ */
+uint8 LCD_enqueueString(const char *a_lcdString);
+
+/**
+ * @brief Queues a string stored in flash memory to be displayed from the cursor position by the Timer0 tick.
+ *
+ * @param a_lcdString Pointer to the null-terminated string in flash memory (PSTR or PROGMEM).
+ * @return The number of characters queued, less than the string length if the queue got full.
+ */
+uint8 LCD_enqueueString_P(const char *a_lcdString);
+
+/**
+ * @brief Gets the number of bytes waiting in the transmit queue.
+ *
+ * @return The queue depth (0 to LCD_QUEUE_SIZE).
+ */
+uint8 LCD_getQueueDepth(void);
+#endif
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @enum LCD_ERROR
+ * @brief Defines possible error codes for LCD operations.
+ *
+ * These error codes are used to signal whether a certain operation was successful or if an issue occurred (e.g., exceeding column limits).
+ */
+typedef enum {
+    SUCSSES,         /**< Indicates successful completion of an operation. */
+    EXCEEDMAXCOLUMNS /**< Indicates that the operation exceeded the maximum column limit of the LCD. */
+} LCD_ERROR;
+void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str);
+void LCD_displayStringRowColumn_P(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString);
+#endif /* LCD_H_ */
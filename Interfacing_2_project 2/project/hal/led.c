@@ -1,28 +1,111 @@
-#include"../mcal/gpio.h"
-#include"../common/std_types.h"
-#include"led.h"
-uint8 LED_pins[] = { GPIO_PC2, GPIO_PC1, GPIO_PC0 };
-void LED_init() {
-	for (int i; i < sizeof(LED_pins); i++) {
-		GPIO_ARR_setPinDirection(LED_pins[i], PIN_OUTPUT);
-	}
-}
-
-void LED_on(uint8 a_ledid) {
-#ifdef LED_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(LED_pins[a_ledid], LOGIC_HIGH);
-#else
-	GPIO_ARR_setPinState(LED_pins[a_ledid],LOGIC_LOW);
-#endif
-
-}
-
-void LED_off(uint8 a_ledid) {
-#ifdef LED_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(LED_pins[a_ledid], LOGIC_LOW);
-#else
-	GPIO_ARR_setPinState(LED_pins[a_ledid],LOGIC_HIGH);
-#endif
-
-}
-
+#include"../mcal/gpio.h"
+#include"../mcal/timer0.h"
+#include"../mcal/atmega32_regs.h"
+#include"../common/std_types.h"
+#include"led.h"
+#include<avr/interrupt.h>
+
+uint8 LED_pins[] = { GPIO_PC2, GPIO_PC1, GPIO_PC0 };
+
+#define LED_COUNT (sizeof(LED_pins))
+#define LED_ALL_MASK (LED_MASK(LED_BLUE_1) | LED_MASK(LED_GREEN_2) | LED_MASK(LED_RED_3))
+
+/* Effect of every LED, written with interrupts disabled and read by the Timer0 tick */
+static uint8 g_dutySteps[LED_COUNT];   /* PWM steps on out of LED_PWM_STEPS */
+static uint16 g_blinkTicks[LED_COUNT]; /* Ticks per blink half period, 0 is steady */
+static uint16 g_blinkCount[LED_COUNT]; /* Ticks spent in the current blink half */
+static uint8 g_blinkOn = LED_ALL_MASK; /* LEDs in the on half of their blink */
+
+/* Tick state */
+static uint8 g_pwmPhase = 0;
+static uint8 g_portMask = 0;
+static boolean g_tickStarted = FALSE; /* Set once LED_process is registered with Timer0 */
+
+/* Timer0 tick: advances the blink halves and the PWM period, then writes all the LEDs at once */
+static void LED_process(void) {
+	uint8 i, portValue = 0;
+
+	g_pwmPhase++;
+	if (g_pwmPhase >= LED_PWM_STEPS) {
+		g_pwmPhase = 0;
+	}
+
+	for (i = 0; i < LED_COUNT; i++) {
+		if (g_blinkTicks[i] != 0) {
+			g_blinkCount[i]++;
+			if (g_blinkCount[i] >= g_blinkTicks[i]) {
+				g_blinkCount[i] = 0;
+				g_blinkOn ^= LED_MASK(i);
+			}
+		}
+		if ((g_blinkOn & LED_MASK(i)) && (g_pwmPhase < g_dutySteps[i])) {
+			portValue |= 1 << GPIO_FAST_BIT(LED_pins[i]);
+		}
+	}
+
+#ifdef LED_POSTIVE_LOGIC
+	GPIO_writePortMasked(LED_PORT_ID, g_portMask, portValue);
+#else
+	GPIO_writePortMasked(LED_PORT_ID, g_portMask, ~portValue);
+#endif
+}
+
+/* Sets the effect of the LEDs of the mask, the tick applies it within LED_TICK_MS */
+static void LED_apply(uint8 a_ledMask, uint8 a_dutySteps, uint16 a_blinkTicks) {
+	uint8 i;
+	uint8 l_sreg = SREG_REG.byte;
+
+	cli();
+	for (i = 0; i < LED_COUNT; i++) {
+		if (a_ledMask & LED_MASK(i)) {
+			g_dutySteps[i] = a_dutySteps;
+			g_blinkTicks[i] = a_blinkTicks;
+			g_blinkCount[i] = 0;
+			g_blinkOn |= LED_MASK(i);
+		}
+	}
+	SREG_REG.byte = l_sreg;
+}
+
+void LED_init() {
+	uint8 i;
+
+	for (i = 0; i < LED_COUNT; i++) {
+		GPIO_ARR_setPinDirection(LED_pins[i], PIN_OUTPUT);
+		g_portMask |= 1 << GPIO_FAST_BIT(LED_pins[i]);
+	}
+
+	/* All off until an effect is set, the tick keeps writing the pins from now on */
+	LED_apply(LED_ALL_MASK, 0, 0);
+	if (!g_tickStarted) {
+		g_tickStarted = Timer0_addCallBack(LED_process);
+	}
+}
+
+void LED_on(uint8 a_ledid) {
+	LED_apply(LED_MASK(a_ledid), LED_PWM_STEPS, 0);
+}
+
+void LED_off(uint8 a_ledid) {
+	LED_apply(LED_MASK(a_ledid), 0, 0);
+}
+
+void LED_setMask(uint8 a_ledMask) {
+	uint8 l_sreg = SREG_REG.byte;
+
+	/* Both halves in the same tick */
+	cli();
+	LED_apply(a_ledMask, LED_PWM_STEPS, 0);
+	LED_apply(LED_ALL_MASK & ~a_ledMask, 0, 0);
+	SREG_REG.byte = l_sreg;
+}
+
+void LED_setEffect(uint8 a_ledMask, uint8 a_dutyPercent, uint16 a_blinkPeriodMs) {
+	if (a_dutyPercent > 100) {
+		a_dutyPercent = 100;
+	}
+
+	/* Rounded to the nearest PWM step, the blink period is split in two halves */
+	LED_apply(a_ledMask, ((uint16) a_dutyPercent * LED_PWM_STEPS + 50) / 100,
+			a_blinkPeriodMs / (2 * LED_TICK_MS));
+}
@@ -1,22 +1,40 @@
-/*
- * led.h
- *
- *  Created on: 7 Oct 2024
- *      Author: MSI
- */
-
-#ifndef LED_H_
-#define LED_H_
-
-typedef enum {
-	LED_BLUE_1, LED_GREEN_2, LED_RED_3
-} LED_ID;
-#define LED_POSTIVE_LOGIC
-
-#ifndef LED_POSTIVE_LOGIC
-#define LED_NEGATIVE_LOGIC
-#endif
-void LED_init();
-void LED_off(uint8);
-void LED_on(uint8);
-#endif /* LED_H_ */
+/*
+ * led.h
+ *
+ *  Created on: 7 Oct 2024
+ *      Author: MSI
+ */
+
+#ifndef LED_H_
+#define LED_H_
+
+#include"../common/std_types.h"
+
+typedef enum {
+	LED_BLUE_1, LED_GREEN_2, LED_RED_3
+} LED_ID;
+#define LED_POSTIVE_LOGIC
+/* All the LED pins must be on this port for LED_setMask() */
+#define LED_PORT_ID PORTC_ID
+/* Bit of an LED_ID in the masks of LED_setMask() */
+#define LED_MASK(id) (1 << (id))
+
+/* The pins have no PWM output, brightness and blinking are generated from the Timer0 tick */
+#define LED_TICK_MS 1
+/* Brightness levels of one PWM period, LED_PWM_STEPS * LED_TICK_MS must stay under ~10 ms to avoid flicker */
+#define LED_PWM_STEPS 10
+
+#ifndef LED_POSTIVE_LOGIC
+#define LED_NEGATIVE_LOGIC
+#endif
+void LED_init();
+void LED_off(uint8);
+void LED_on(uint8);
+/* Turns on the LEDs set in the mask and off the others, all at once */
+void LED_setMask(uint8);
+/*
+ * Sets the brightness in percent and the blink period in ms of the LEDs set in the mask, 0 ms is steady.
+ * The others keep their effect, LEDs set together blink in phase starting on.
+ */
+void LED_setEffect(uint8, uint8, uint16);
+#endif /* LED_H_ */
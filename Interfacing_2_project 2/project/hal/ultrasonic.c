@@ -1,135 +1,839 @@
-#include "ultrasonic.h"
-#include "../mcal/icu.h"
-#include "../mcal/gpio.h"
-#include "../mcal/atmega32_regs.h"
-#include <util/delay.h>
-#include <avr/interrupt.h>
-
-/**
- * @brief Global variable to store the duration of the echo pulse in timer ticks.
- *
- * This variable stores the high pulse duration (time between trigger and received echo)
- * measured by the Input Capture Unit (ICU).
- */
-static volatile uint16 g_timeHigh = 0;
-
-/**
- * @brief Global variable to track the number of edges detected by the ICU.
- *
- * Used to determine whether a rising or falling edge is detected.
- * - `0`: Rising edge detected (start of echo pulse)
- * - `1`: Falling edge detected (end of echo pulse)
- */
-static volatile uint8 g_edgeCount = 0;
-
-/**
- * @brief Global flag indicating whether a valid echo pulse has been received.
- *
- * Set to `1` when the echo pulse measurement is complete and the distance is ready to be calculated.
- * Cleared to `0` once the distance is processed.
- */
-static volatile uint8 g_readyFlag = 0;
-
-/**
- * @brief Initializes the ultrasonic sensor by setting up the ICU and the trigger pin.
- *
- * This function initializes the ICU to detect the echo pulse duration from the ultrasonic sensor.
- * It configures the ICU to initially detect a rising edge (start of the pulse) and sets up the
- * ultrasonic sensor's trigger pin as an output.
- *
- * It also enables global interrupts for proper ICU operation.
- *
- * @return void
- */
-void Ultrasonic_init(void) {
-    ICU_ConfigType icuConfig = { F_CPU_8, RAISING };  /**< ICU configuration: prescaler and rising edge */
-    ICU_init(&icuConfig);                             /**< Initialize the ICU with the given configuration */
-
-    /* Set callback for edge processing function (to be called when ICU detects edges) */
-    ICU_setCallBack(Ultrasonic_edgeProcessing);
-
-    /* Configure the ultrasonic trigger pin as output */
-    GPIO_ARR_setPinDirection(ULTRASONIC_TRIGGER_PIN, PIN_OUTPUT);
-
-    /* Enable global interrupts */
-    sei();
-}
-
-/**
- * @brief Sends a trigger pulse to the ultrasonic sensor.
- *
- * The ultrasonic sensor requires a 10µs high pulse on its trigger pin to start measuring the distance.
- * This function generates that pulse by setting the trigger pin high for 10µs and then setting it low.
- *
- * @return void
- */
-void Ultrasonic_Trigger(void) {
-    /* Set the trigger pin high */
-    GPIO_ARR_setPinState(ULTRASONIC_TRIGGER_PIN, LOGIC_HIGH);
-
-    /* Wait for 10 microseconds */
-    _delay_us(10);
-
-    /* Set the trigger pin low */
-    GPIO_ARR_setPinState(ULTRASONIC_TRIGGER_PIN, LOGIC_LOW);
-}
-
-/**
- * @brief Reads the distance measured by the ultrasonic sensor in centimeters.
- *
- * This function triggers the ultrasonic sensor, waits for the echo to be processed, and calculates
- * the distance based on the time taken for the echo pulse to return.
- *
- * The distance is calculated using the formula: \f$Distance = \frac{timeHigh}{117.647}\f$
- * where `timeHigh` is the duration of the echo pulse measured in timer ticks.
- *
- * @return The measured distance in centimeters.
- */
-uint16 Ultrasonic_readDistance(void) {
-    uint16 l_distance = 0;  /**< Local variable to store the calculated distance */
-
-    /* Trigger the ultrasonic sensor to start measurement */
-    Ultrasonic_Trigger();
-
-    /* Enable ICU interrupt to start edge detection */
-    ICU_interruptOn();
-
-    /* Wait for the echo pulse to be processed (handled by the ICU interrupt) */
-    while (!g_readyFlag);  /**< Wait until the echo pulse is processed */
-
-    /* Disable ICU interrupt after measurement is done */
-    ICU_interruptOff();
-
-    /* Reset the ready flag for the next measurement */
-    g_readyFlag = LOGIC_LOW;
-
-    /* Calculate the distance in centimeters based on the timeHigh value */
-    l_distance = (uint16) ((g_timeHigh) / 117);  /**< Calculate the distance */
-
-    return l_distance;
-}
-
-/**
- * @brief ICU callback function to process rising and falling edges of the echo pulse.
- *
- * This function is called by the ICU interrupt service routine whenever an edge (rising or falling)
- * is detected. On the first call (rising edge), it resets the timer and switches to detect the falling edge.
- * On the second call (falling edge), it calculates the time duration of the echo pulse and signals
- * that the distance measurement is ready.
- *
- * @return void
- */
-void Ultrasonic_edgeProcessing(void) {
-    if (g_edgeCount == 0) {
-        /* Rising edge detected: start measuring the echo pulse */
-        ICU_clearTimerValue();                      /**< Clear the ICU timer */
-        ICU_setEdgeDetectionType(FALLING);          /**< Switch to falling edge detection */
-        g_edgeCount++;                              /**< Increment edge count */
-    } else if (g_edgeCount == 1) {
-        /* Falling edge detected: echo pulse received, calculate timeHigh */
-        g_timeHigh = ICU_getInputCaptureValue();    /**< Store the time duration of the echo pulse */
-        g_readyFlag = LOGIC_HIGH;                   /**< Set the ready flag to indicate valid measurement */
-        ICU_setEdgeDetectionType(RAISING);          /**< Reset to rising edge detection for next measurement */
-        g_edgeCount = 0;                            /**< Reset edge count for next cycle */
-    }
-}
+#include "ultrasonic.h"
+#include "../mcal/icu.h"
+#include "../mcal/gpio.h"
+#include "../mcal/timer0.h"
+#include "../mcal/atmega32_regs.h"
+#include "../common/common_macros.h"
+#include <util/delay.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Descriptors of the sensor array, stored in flash memory.
+ */
+static const Ultrasonic_SensorType g_sensors[ULTRASONIC_SENSOR_COUNT] PROGMEM = ULTRASONIC_SENSORS;
+
+/**
+ * @brief Timer clock and precomputed conversion constants of an echo timer range.
+ */
+typedef struct {
+    uint16 mmPerTick;     /**< Millimeters per tick at ULTRASONIC_SPEED_OF_SOUND_MM_S with mmShift fraction bits. */
+    uint16 cmPerTick;     /**< Centimeters per tick at ULTRASONIC_SPEED_OF_SOUND_MM_S with cmShift fraction bits. */
+    uint8 mmShift;
+    uint8 cmShift;
+    uint8 referenceShift; /**< Right shift converting the ticks to ULTRASONIC_ICU_CLOCK ticks. */
+} Ultrasonic_RangeType;
+
+/**
+ * @brief Builds the entry of a range from the clock of its ticks, all the constants are evaluated at compile time.
+ */
+#define ULTRASONIC_RANGE(clock, mmShift, cmShift, referenceShift) \
+    { ULTRASONIC_CLOCK_TICK_FACTOR(clock, ULTRASONIC_SPEED_OF_SOUND_MM_S, mmShift), \
+      ULTRASONIC_CLOCK_TICK_FACTOR(clock, ULTRASONIC_SPEED_OF_SOUND_MM_S / 10, cmShift), \
+      mmShift, cmShift, referenceShift }
+
+/**
+ * @brief Echo timer ranges indexed by ULTRASONIC_NEAR_RANGE and ULTRASONIC_FAR_RANGE, stored in flash memory.
+ */
+static const Ultrasonic_RangeType g_ranges[ULTRASONIC_RANGE_COUNT] PROGMEM = {
+    ULTRASONIC_RANGE(ULTRASONIC_TIMER_CLOCK, ULTRASONIC_NEAR_MM_SHIFT, ULTRASONIC_NEAR_CM_SHIFT,
+            ULTRASONIC_NEAR_REFERENCE_SHIFT),
+    ULTRASONIC_RANGE(ULTRASONIC_ICU_CLOCK, ULTRASONIC_MM_SHIFT, ULTRASONIC_CM_SHIFT, 0)
+};
+
+/**
+ * @brief ULTRASONIC_TIMEOUT_TICKS in ULTRASONIC_TIMER_CLOCK ticks, the unit of the ICU timestamps.
+ */
+#define ULTRASONIC_TIMEOUT_TIMER_TICKS (ULTRASONIC_TIMEOUT_TICKS << ULTRASONIC_NEAR_REFERENCE_SHIFT)
+
+/**
+ * @brief Echo of ULTRASONIC_MIN_DISTANCE_MM in ULTRASONIC_TIMER_CLOCK ticks, shorter ones are out of range.
+ */
+#define ULTRASONIC_MIN_TIMER_TICKS ULTRASONIC_MM_TO_TICKS(ULTRASONIC_TIMER_CLOCK, ULTRASONIC_MIN_DISTANCE_MM)
+
+/**
+ * @brief Conversion factors of an echo timer range for the calibrated speed of sound.
+ */
+typedef struct {
+    uint16 mmPerTick;     /**< Millimeters per tick with the mmShift fraction bits of the range. */
+    uint16 cmPerTick;     /**< Centimeters per tick with the cmShift fraction bits of the range. */
+} Ultrasonic_FactorsType;
+
+/**
+ * @brief Calibrated factors of every range, regenerated by Ultrasonic_setCalibration() only.
+ */
+static Ultrasonic_FactorsType g_factors[ULTRASONIC_RANGE_COUNT];
+
+/**
+ * @brief Calibration offset added to every distance in millimeters and in centimeters.
+ */
+static sint16 g_offsetMm = 0;
+static sint16 g_offsetCm = 0;
+
+/**
+ * @brief Global variable to store the duration of the echo pulse in timer ticks.
+ *
+ * This variable stores the high pulse duration (time between trigger and received echo)
+ * measured by the Input Capture Unit (ICU).
+ */
+static volatile uint16 g_timeHigh = 0;
+
+/**
+ * @brief Echo timer range of g_timeHigh, the far range when the echo did not fit 16 bits of timer ticks.
+ */
+static volatile uint8 g_timeRange = ULTRASONIC_FAR_RANGE;
+
+/**
+ * @brief Global variable to track the number of edges detected by the ICU.
+ *
+ * Used to determine whether a rising or falling edge is detected.
+ * - `0`: Rising edge detected (start of echo pulse)
+ * - `1`: Falling edge detected (end of echo pulse)
+ */
+static volatile uint8 g_edgeCount = 0;
+
+/**
+ * @brief Global status of the current measurement.
+ *
+ * Set to `ULTRASONIC_PENDING` when a measurement is started, then to `ULTRASONIC_READY` by the falling
+ * edge or to `ULTRASONIC_TIMEOUT` by the Timer1 overflow. Returned to `ULTRASONIC_IDLE` once collected.
+ */
+static volatile Ultrasonic_StatusType g_status = ULTRASONIC_IDLE;
+
+/**
+ * @brief Timer1 timestamp of the trigger, then of the echo rising edge, the timeout runs from it.
+ */
+static volatile uint32 g_echoStart = 0;
+
+/**
+ * @brief Index of the sensor measured by the current or last measurement.
+ */
+static uint8 g_currentSensor = 0;
+
+/**
+ * @brief TRUE while the trigger pin of the current sensor is held high by the round-robin.
+ *
+ * The tick raises the trigger and the next tick drops it, 1 ms covers the 10 us the HC-SR04 needs
+ * without a busy wait in the interrupt.
+ */
+static boolean g_triggerHigh = FALSE;
+
+/**
+ * @brief Set once the round-robin is registered with Timer0.
+ */
+static boolean g_roundRobinStarted = FALSE;
+
+/**
+ * @brief Latest distance of every sensor in millimeters, written by the Timer0 tick.
+ */
+static volatile uint16 g_distanceMm[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @brief Echo pulse of the latest reading of every sensor in Timer1 ticks, 0 when it timed out.
+ */
+static volatile uint16 g_echoTicks[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @brief Bit i is set when sensor i has a reading not collected by Ultrasonic_getReading() yet.
+ */
+static volatile uint8 g_newReadings = 0;
+
+#if ULTRASONIC_SENSOR_COUNT > 8
+#error "g_newReadings holds at most 8 sensors"
+#endif
+
+/**
+ * @brief Tick of the last ping of every sensor.
+ */
+static uint32 g_lastPing[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @brief Tick at which the last measurement completed, the guard time starts from it.
+ */
+static uint32 g_lastDone = 0;
+
+/**
+ * @brief Minimum number of ticks between two pings of the same sensor, 0 when the round-robin is stopped.
+ */
+static volatile uint16 g_pingInterval = ULTRASONIC_MIN_CYCLE_MS / ULTRASONIC_TICK_MS;
+
+/**
+ * @brief Mask wrapping the free-running sample ring indices to a ring slot.
+ */
+#define ULTRASONIC_SAMPLE_RING_MASK (ULTRASONIC_SAMPLE_RING_SIZE - 1)
+
+/**
+ * @brief Sample ring, filled by the ICU interrupts and drained by Ultrasonic_readSamples().
+ *
+ * Volatile so the copy out of a slot is never moved after the tail update that frees it.
+ */
+static volatile Ultrasonic_SampleType g_sampleRing[ULTRASONIC_SAMPLE_RING_SIZE];
+
+/**
+ * @brief Free-running ring indices, only the ICU interrupts write the head and only the consumer writes the tail.
+ *
+ * Both are single bytes, so each side reads the index of the other without disabling interrupts.
+ */
+static volatile uint8 g_sampleHead = 0;
+static volatile uint8 g_sampleTail = 0;
+
+/**
+ * @brief Number of measurements dropped because the ring was full.
+ */
+static volatile uint16 g_sampleOverflows = 0;
+
+/**
+ * @brief Pushes the finished measurement of the current sensor into the sample ring.
+ *
+ * Called from the ICU capture and Timer1 overflow interrupts only, which never interrupt each
+ * other, so the ring has a single producer. The distance is converted by the consumer.
+ *
+ * @param a_ticks The echo width in timer ticks of the range, 0 unless the echo is valid.
+ * @param a_range The echo timer range of the ticks.
+ * @param a_echo What the measurement received (Ultrasonic_EchoType).
+ */
+static void Ultrasonic_pushSample(uint16 a_ticks, uint8 a_range, uint8 a_echo) {
+    uint8 l_head = g_sampleHead;
+    volatile Ultrasonic_SampleType *l_sample;
+
+    if ((uint8) (l_head - g_sampleTail) >= ULTRASONIC_SAMPLE_RING_SIZE) {
+        if (g_sampleOverflows != 0xFFFF) {
+            g_sampleOverflows++;                    /**< Keep the older samples, drop this one */
+        }
+        return;
+    }
+
+    l_sample = &g_sampleRing[l_head & ULTRASONIC_SAMPLE_RING_MASK];
+    l_sample->timestamp = Timer0_getTimestamp();
+    l_sample->echoTicks = a_ticks;
+    l_sample->sensor = g_currentSensor;
+    l_sample->range = a_range;
+    l_sample->echo = a_echo;
+    g_sampleHead = l_head + 1;                      /**< Publish the sample after it is written */
+}
+
+/**
+ * @brief Adds the calibration offset to a distance, limited to the valid distances.
+ *
+ * @param a_distance The distance before the offset.
+ * @param a_offset The offset in the unit of the distance.
+ * @return The distance, 0 at least and below ULTRASONIC_NO_ECHO_DISTANCE.
+ */
+static uint16 Ultrasonic_addOffset(uint16 a_distance, sint16 a_offset) {
+    sint32 l_distance = (sint32) a_distance + a_offset;
+
+    if (l_distance < 0) {
+        return 0;
+    }
+    if (l_distance >= ULTRASONIC_NO_ECHO_DISTANCE) {
+        return ULTRASONIC_NO_ECHO_DISTANCE - 1;
+    }
+    return (uint16) l_distance;
+}
+
+/**
+ * @brief Converts echo ticks of a range to millimeters with one multiplication and a shift.
+ *
+ * @param a_ticks The echo width in ticks of the range.
+ * @param a_range The echo timer range.
+ * @return The calibrated distance in millimeters.
+ */
+static uint16 Ultrasonic_ticksToMm(uint16 a_ticks, uint8 a_range) {
+    return Ultrasonic_addOffset((uint16) (((uint32) a_ticks * g_factors[a_range].mmPerTick)
+            >> pgm_read_byte(&g_ranges[a_range].mmShift)), g_offsetMm);
+}
+
+/**
+ * @brief Converts echo ticks of a range to centimeters with one multiplication and a shift.
+ *
+ * @param a_ticks The echo width in ticks of the range.
+ * @param a_range The echo timer range.
+ * @return The calibrated distance in centimeters.
+ */
+static uint16 Ultrasonic_ticksToCm(uint16 a_ticks, uint8 a_range) {
+    return Ultrasonic_addOffset((uint16) (((uint32) a_ticks * g_factors[a_range].cmPerTick)
+            >> pgm_read_byte(&g_ranges[a_range].cmShift)), g_offsetCm);
+}
+
+/**
+ * @brief Scales a conversion factor of the speed of sound of the build, rounded and saturated.
+ *
+ * @param a_factor The factor at ULTRASONIC_SPEED_OF_SOUND_MM_S.
+ * @param a_speedScale The speed of sound relative to it in Q15.
+ * @return The scaled factor.
+ */
+static uint16 Ultrasonic_scaleFactor(uint16 a_factor, uint16 a_speedScale) {
+    uint32 l_factor = (((uint32) a_factor * a_speedScale) >> 1) + (1UL << 13);
+
+    l_factor >>= 14;
+    return (l_factor > 0xFFFF) ? 0xFFFF : (uint16) l_factor;
+}
+
+/**
+ * @brief Converts echo ticks of a range to ULTRASONIC_ICU_CLOCK ticks.
+ *
+ * @param a_ticks The echo width in ticks of the range.
+ * @param a_range The echo timer range.
+ * @return The echo width in ULTRASONIC_ICU_CLOCK ticks.
+ */
+static uint16 Ultrasonic_referenceTicks(uint16 a_ticks, uint8 a_range) {
+    return a_ticks >> pgm_read_byte(&g_ranges[a_range].referenceShift);
+}
+
+/**
+ * @brief Initializes the ultrasonic sensor by setting up the ICU and the trigger pin.
+ *
+ * This function initializes the ICU to detect the echo pulse duration from the ultrasonic sensor.
+ * It configures the ICU to initially detect a rising edge (start of the pulse) and sets up the
+ * ultrasonic sensor's trigger pin as an output.
+ *
+ * It also registers the round-robin on the Timer0 tick and enables global interrupts for proper ICU operation.
+ * The first sensor is pinged on the next tick, not one measurement cycle later.
+ *
+ * @return void
+ */
+void Ultrasonic_init(void) {
+    uint8 i;
+    uint32 l_now = Timer0_getTicks();
+    ICU_ConfigType icuConfig = { ULTRASONIC_TIMER_CLOCK, RAISING };  /**< ICU configuration: prescaler and rising edge */
+    Ultrasonic_setCalibration(ULTRASONIC_SPEED_SCALE_ONE, 0);  /**< Uncalibrated conversion */
+    ICU_init(&icuConfig);                             /**< Initialize the ICU with the given configuration */
+    ICU_interruptOff();                               /**< Edges are only of interest once a measurement starts */
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+    /* Set callback for edge processing function (to be called when ICU detects edges) */
+    ICU_setCallBack(Ultrasonic_edgeProcessing);
+#endif
+
+    /* Set callback for the measurement timeout (to be called when Timer1 overflows) */
+    ICU_setOverflowCallBack(Ultrasonic_overflowProcessing);
+
+    /* Configure the trigger pins as output, no sensor was measured yet */
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        GPIO_ARR_setPinDirection(pgm_read_byte(&g_sensors[i].triggerPin), PIN_OUTPUT);
+        g_distanceMm[i] = ULTRASONIC_NO_ECHO_DISTANCE;
+        g_echoTicks[i] = 0;
+        g_lastPing[i] = l_now - 0xFFFFUL;  /**< Due at once, whatever the ping interval */
+    }
+    g_lastDone = l_now - 0xFFUL;          /**< No reflection to wait for before the first ping */
+    g_sampleHead = 0;
+    g_sampleTail = 0;
+    g_sampleOverflows = 0;
+#ifdef ULTRASONIC_ECHO_SELECT_S0
+    GPIO_ARR_setPinDirection(ULTRASONIC_ECHO_SELECT_S0, PIN_OUTPUT);
+    GPIO_ARR_setPinDirection(ULTRASONIC_ECHO_SELECT_S1, PIN_OUTPUT);
+#endif
+
+    /* Run the round-robin on the Timer0 tick */
+    if (!g_roundRobinStarted) {
+        g_roundRobinStarted = Timer0_addCallBack(Ultrasonic_process);
+    }
+
+    /* Enable global interrupts */
+    sei();
+}
+
+/**
+ * @brief Sends a trigger pulse to the ultrasonic sensor.
+ *
+ * The ultrasonic sensor requires a 10µs high pulse on its trigger pin to start measuring the distance.
+ * This function generates that pulse on the trigger pin of the current sensor.
+ *
+ * @return void
+ */
+void Ultrasonic_Trigger(void) {
+    uint8 l_pin = pgm_read_byte(&g_sensors[g_currentSensor].triggerPin);
+
+    /* Set the trigger pin high */
+    GPIO_ARR_setPinState(l_pin, LOGIC_HIGH);
+
+    /* Wait for 10 microseconds */
+    _delay_us(10);
+
+    /* Set the trigger pin low */
+    GPIO_ARR_setPinState(l_pin, LOGIC_LOW);
+}
+
+/**
+ * @brief Arms the ICU for a measurement of the current sensor, the trigger pulse is sent by the caller.
+ *
+ * This function resets the edge detection, takes the Timer1 timestamp the timeout starts counting
+ * from and enables the ICU interrupt and the overflow callback.
+ * Timer1 itself is left running at one rate, it is the timebase of other modules too.
+ *
+ * @return void
+ */
+static void Ultrasonic_armMeasurement(void) {
+    /* Stop any measurement still in flight before re-arming */
+    ICU_interruptOff();
+    ICU_overflowInterruptOff();
+
+    g_edgeCount = 0;                            /**< Expect the rising edge first */
+    g_echoStart = ICU_getTimestamp();           /**< Restart the timeout */
+    g_status = ULTRASONIC_PENDING;              /**< Mark the measurement as in flight */
+    ICU_setEdgeDetectionType(RAISING);
+
+    /* Enable ICU interrupt to start edge detection and the overflow interrupt for the timeout */
+    ICU_interruptOn();
+    ICU_overflowInterruptOn();
+}
+
+/**
+ * @brief Starts a distance measurement without waiting for the echo.
+ *
+ * This function arms the ICU and the Timer1 overflow timeout, then sends the trigger pulse.
+ *
+ * @return void
+ */
+void Ultrasonic_startMeasurement(void) {
+    Ultrasonic_armMeasurement();
+
+    /* Trigger the ultrasonic sensor to start measurement */
+    Ultrasonic_Trigger();
+}
+
+/**
+ * @brief Collects the echo width of a finished measurement.
+ *
+ * READY and TIMEOUT are reported only once, the status then returns to IDLE.
+ *
+ * @param a_ticks Pointer that receives the echo width in timer ticks when READY is returned.
+ * @param a_range Pointer that receives the echo timer range of the ticks when READY is returned.
+ * @return The status of the current measurement.
+ */
+static Ultrasonic_StatusType Ultrasonic_getEcho(uint16 *a_ticks, uint8 *a_range) {
+    Ultrasonic_StatusType l_status = g_status;  /**< Snapshot, the ISRs only move it away from PENDING */
+
+    if (l_status == ULTRASONIC_READY) {
+        /* g_timeHigh is not written again until the next measurement is started */
+        *a_ticks = g_timeHigh;
+        *a_range = g_timeRange;
+        g_status = ULTRASONIC_IDLE;
+    } else if (l_status == ULTRASONIC_TIMEOUT) {
+        g_status = ULTRASONIC_IDLE;
+    }
+
+    return l_status;
+}
+
+/**
+ * @brief Polls the measurement started by Ultrasonic_startMeasurement().
+ *
+ * When the echo was received, the distance is calculated as
+ * \f$Distance = timeHigh \times cmPerTick / 2^{cmShift}\f$ where `timeHigh` is the duration of the
+ * echo pulse measured in timer ticks and the constants are those of its range for the calibrated
+ * speed of sound, so no division is done at run time. The calibration offset is added last.
+ *
+ * @param a_distance Pointer that receives the distance in centimeters when READY is returned.
+ * @return The status of the current measurement.
+ */
+Ultrasonic_StatusType Ultrasonic_getResult(uint16 *a_distance) {
+    uint16 l_ticks;
+    uint8 l_range;
+    Ultrasonic_StatusType l_status = Ultrasonic_getEcho(&l_ticks, &l_range);
+
+    if (l_status == ULTRASONIC_READY) {
+        *a_distance = Ultrasonic_ticksToCm(l_ticks, l_range);
+    }
+    return l_status;
+}
+
+/**
+ * @brief Polls the measurement started by Ultrasonic_startMeasurement() in millimeters.
+ *
+ * @param a_distance Pointer that receives the distance in millimeters when READY is returned.
+ * @return The status of the current measurement.
+ */
+Ultrasonic_StatusType Ultrasonic_getResultMm(uint16 *a_distance) {
+    uint16 l_ticks;
+    uint8 l_range;
+    Ultrasonic_StatusType l_status = Ultrasonic_getEcho(&l_ticks, &l_range);
+
+    if (l_status == ULTRASONIC_READY) {
+        *a_distance = Ultrasonic_ticksToMm(l_ticks, l_range);
+    }
+    return l_status;
+}
+
+/**
+ * @brief Reads the distance measured by the ultrasonic sensor in centimeters.
+ *
+ * This function starts a measurement and waits until the echo is processed or the Timer1
+ * overflow timeout expires, so it never blocks for more than about two Timer1 periods.
+ *
+ * @return The measured distance in centimeters, or ULTRASONIC_NO_ECHO_DISTANCE on timeout.
+ */
+uint16 Ultrasonic_readDistance(void) {
+    uint16 l_distance = ULTRASONIC_NO_ECHO_DISTANCE;  /**< Local variable to store the calculated distance */
+
+    Ultrasonic_startMeasurement();
+
+    /* Wait for the echo pulse to be processed (handled by the ICU and overflow interrupts) */
+    while (Ultrasonic_getResult(&l_distance) == ULTRASONIC_PENDING);
+
+    return l_distance;
+}
+
+/**
+ * @brief Reads the distance measured by the ultrasonic sensor in millimeters.
+ *
+ * @return The measured distance in millimeters, or ULTRASONIC_NO_ECHO_DISTANCE on timeout.
+ */
+uint16 Ultrasonic_readDistanceMm(void) {
+    uint16 l_distance = ULTRASONIC_NO_ECHO_DISTANCE;
+
+    Ultrasonic_startMeasurement();
+
+    /* Wait for the echo pulse to be processed (handled by the ICU and overflow interrupts) */
+    while (Ultrasonic_getResultMm(&l_distance) == ULTRASONIC_PENDING);
+
+    return l_distance;
+}
+
+/**
+ * @brief Processes the rising and falling edges of the echo pulse.
+ *
+ * This function is run by the ICU interrupt service routine whenever an edge (rising or falling)
+ * is detected. On the first call (rising edge), it keeps the capture timestamp and switches to detect the
+ * falling edge. On the second call (falling edge), the echo width is the difference of the two 32-bit
+ * capture timestamps, so it stays exact across Timer1 wraps, and the measurement is signaled ready.
+ * The echo is auto-ranged by its width: it keeps the timer resolution when it fits 16 bits, a
+ * wider one is kept in ULTRASONIC_ICU_CLOCK ticks instead.
+ * Always inlined, into the capture vector itself in ICU_DIRECT_CAPTURE_MODE.
+ *
+ * @param a_timestamp The 32-bit capture timestamp of the edge.
+ * @return void
+ */
+static inline __attribute__((always_inline)) void Ultrasonic_edge(uint32 a_timestamp) {
+    uint32 l_width;
+    uint8 l_range = ULTRASONIC_NEAR_RANGE;
+
+    if (g_edgeCount == 0) {
+        /* Rising edge detected: start measuring the echo pulse */
+        g_echoStart = a_timestamp;                  /**< The timeout now bounds the echo width */
+        ICU_setEdgeDetectionType(FALLING);          /**< Switch to falling edge detection */
+        g_edgeCount++;                              /**< Increment edge count */
+    } else if (g_edgeCount == 1) {
+        /* Falling edge detected: echo pulse received, calculate timeHigh */
+        l_width = a_timestamp - g_echoStart;
+        ICU_interruptOff();                         /**< Measurement done, ignore further edges */
+        ICU_overflowInterruptOff();                 /**< Cancel the timeout */
+        ICU_setEdgeDetectionType(RAISING);          /**< Reset to rising edge detection for next measurement */
+        g_edgeCount = 0;                            /**< Reset edge count for next cycle */
+        if (l_width >= ULTRASONIC_TIMEOUT_TIMER_TICKS) {
+            g_status = ULTRASONIC_TIMEOUT;          /**< Beyond the range, the same as a lost echo */
+            Ultrasonic_pushSample(0, ULTRASONIC_FAR_RANGE, ULTRASONIC_ECHO_NONE);
+        } else if (l_width < ULTRASONIC_MIN_TIMER_TICKS) {
+            g_status = ULTRASONIC_TIMEOUT;          /**< Too short to be a distance, never a reading of 0 */
+            Ultrasonic_pushSample(0, ULTRASONIC_FAR_RANGE, ULTRASONIC_ECHO_OUT_OF_RANGE);
+        } else {
+            if (l_width > 0xFFFF) {
+                /* Beyond the near range, fall back to the far range resolution */
+                l_width >>= pgm_read_byte(&g_ranges[l_range].referenceShift);
+                l_range = ULTRASONIC_FAR_RANGE;
+            }
+            g_timeHigh = (uint16) l_width;          /**< Store the time duration of the echo pulse */
+            g_timeRange = l_range;
+            g_status = ULTRASONIC_READY;            /**< Indicate valid measurement */
+            Ultrasonic_pushSample(g_timeHigh, l_range, ULTRASONIC_ECHO_VALID);
+        }
+    }
+}
+
+#ifdef ICU_DIRECT_CAPTURE_MODE
+/**
+ * @brief Capture handler of the ICU vector, gets ICR1 read first and extends it before the edge processing.
+ *
+ * @param a_capture The ICR1 value latched by the edge.
+ * @return void
+ */
+static inline __attribute__((always_inline)) void Ultrasonic_capture(uint16 a_capture) {
+    Ultrasonic_edge(ICU_extendCapture(a_capture));
+}
+
+/* The capture vector, bound at compile time so the handler is inlined without link time optimization */
+ICU_CAPTURE_VECTOR(Ultrasonic_capture)
+#else
+/**
+ * @brief ICU callback function to process rising and falling edges of the echo pulse.
+ *
+ * @return void
+ */
+void Ultrasonic_edgeProcessing(void) {
+    Ultrasonic_edge(ICU_getCaptureTimestamp());
+}
+#endif
+
+/**
+ * @brief Timer1 overflow callback that bounds the time a measurement may stay pending.
+ *
+ * The callback is only enabled while a measurement is pending. Once ULTRASONIC_TIMEOUT_TICKS
+ * elapsed since the trigger or the echo rising edge, the measurement is aborted and reported as
+ * `ULTRASONIC_TIMEOUT`.
+ *
+ * @return void
+ */
+void Ultrasonic_overflowProcessing(void) {
+    if (g_status != ULTRASONIC_PENDING) {
+        return;
+    }
+
+    if ((ICU_getTimestamp() - g_echoStart) >= ULTRASONIC_TIMEOUT_TIMER_TICKS) {
+        ICU_interruptOff();                         /**< Ignore a late echo */
+        ICU_overflowInterruptOff();
+        ICU_setEdgeDetectionType(RAISING);
+        g_status = ULTRASONIC_TIMEOUT;              /**< Indicate the echo was lost */
+        /* An echo that started and never ended is the HC-SR04 finding nothing in range */
+        Ultrasonic_pushSample(0, ULTRASONIC_FAR_RANGE, (g_edgeCount == 0) ? ULTRASONIC_ECHO_LOST : ULTRASONIC_ECHO_NONE);
+        g_edgeCount = 0;
+    }
+}
+
+/**
+ * @brief Round-robin over the sensor array, called by the Timer0 tick.
+ *
+ * Runs in interrupt context like the ICU callbacks, so it never races with them. A measurement
+ * in flight is left to the ICU and overflow interrupts, which bound it to one Timer1 period.
+ * The trigger pulse spans two ticks instead of waiting 10 us here, which would delay the ICU
+ * interrupts and the other tick callbacks on every ping. The HC-SR04 starts its burst on the
+ * falling edge, so the echo comes one tick after the ping.
+ *
+ * @return void
+ */
+void Ultrasonic_process(void) {
+    uint16 l_ticks;
+    uint8 l_range;
+    uint32 l_now;
+    uint8 l_next;
+    Ultrasonic_StatusType l_status;
+
+    if (g_triggerHigh) {
+        /* End of the trigger pulse raised by the previous tick */
+        GPIO_ARR_setPinState(pgm_read_byte(&g_sensors[g_currentSensor].triggerPin), LOGIC_LOW);
+        g_triggerHigh = FALSE;
+    }
+
+    if ((g_pingInterval == 0) || (g_status == ULTRASONIC_PENDING)) {
+        return;  /**< Stopped, or the ICU is busy with the current sensor */
+    }
+
+    l_now = Timer0_getTicks();
+    l_status = Ultrasonic_getEcho(&l_ticks, &l_range);
+    if (l_status == ULTRASONIC_READY) {
+        g_distanceMm[g_currentSensor] = Ultrasonic_ticksToMm(l_ticks, l_range);
+        g_echoTicks[g_currentSensor] = Ultrasonic_referenceTicks(l_ticks, l_range);
+    } else if (l_status == ULTRASONIC_TIMEOUT) {
+        g_distanceMm[g_currentSensor] = ULTRASONIC_NO_ECHO_DISTANCE;
+        g_echoTicks[g_currentSensor] = 0;
+    }
+    if (l_status == ULTRASONIC_READY || l_status == ULTRASONIC_TIMEOUT) {
+        SET_BIT(g_newReadings, g_currentSensor);
+        g_lastDone = l_now;
+    }
+
+    /* Let the reflections of the last ping die out before triggering any sensor */
+    if ((l_now - g_lastDone) < (pgm_read_byte(&g_sensors[g_currentSensor].guardMs) / ULTRASONIC_TICK_MS)) {
+        return;
+    }
+
+    l_next = g_currentSensor + 1;
+    if (l_next >= ULTRASONIC_SENSOR_COUNT) {
+        l_next = 0;
+    }
+    if ((l_now - g_lastPing[l_next]) < g_pingInterval) {
+        return;  /**< The next sensor is still within its measurement cycle */
+    }
+
+    g_currentSensor = l_next;
+    g_lastPing[l_next] = l_now;
+#ifdef ULTRASONIC_ECHO_SELECT_S0
+    {
+        /* Route the echo of the selected sensor to ICP1 */
+        uint8 l_channel = pgm_read_byte(&g_sensors[l_next].echoChannel);
+        GPIO_FAST_SET(ULTRASONIC_ECHO_SELECT_S0, GET_BIT(l_channel, 0));
+        GPIO_FAST_SET(ULTRASONIC_ECHO_SELECT_S1, GET_BIT(l_channel, 1));
+    }
+#endif
+    Ultrasonic_armMeasurement();
+    GPIO_ARR_setPinState(pgm_read_byte(&g_sensors[l_next].triggerPin), LOGIC_HIGH);
+    g_triggerHigh = TRUE;
+}
+
+/**
+ * @brief Sets the minimum time between two pings of the same sensor.
+ *
+ * @param a_intervalMs The ping interval in milliseconds, raised to ULTRASONIC_MIN_CYCLE_MS.
+ *                     0 stops the round-robin after the measurement in flight.
+ *
+ * @return void
+ */
+void Ultrasonic_setPingInterval(uint16 a_intervalMs) {
+    uint8 l_sreg = SREG_REG.byte;
+
+    if (a_intervalMs != 0 && a_intervalMs < ULTRASONIC_MIN_CYCLE_MS) {
+        a_intervalMs = ULTRASONIC_MIN_CYCLE_MS;
+    }
+
+    /* The interval is read by the Timer0 tick, write both bytes with interrupts disabled */
+    cli();
+    g_pingInterval = a_intervalMs / ULTRASONIC_TICK_MS;
+    SREG_REG.byte = l_sreg;
+}
+
+/**
+ * @brief Regenerates the distance conversion for a calibrated speed of sound and distance offset.
+ *
+ * @param a_speedScale Speed of sound relative to ULTRASONIC_SPEED_OF_SOUND_MM_S in Q15, below 2.0.
+ * @param a_offsetMm Millimeters added to every distance, a distance never goes below 0.
+ *
+ * @return void
+ */
+void Ultrasonic_setCalibration(uint16 a_speedScale, sint16 a_offsetMm) {
+    Ultrasonic_FactorsType l_factors[ULTRASONIC_RANGE_COUNT];
+    uint8 l_sreg;
+    uint8 i;
+
+    for (i = 0; i < ULTRASONIC_RANGE_COUNT; i++) {
+        l_factors[i].mmPerTick = Ultrasonic_scaleFactor(pgm_read_word(&g_ranges[i].mmPerTick), a_speedScale);
+        l_factors[i].cmPerTick = Ultrasonic_scaleFactor(pgm_read_word(&g_ranges[i].cmPerTick), a_speedScale);
+    }
+
+    /* The factors are read by the Timer0 tick, replace them all with interrupts disabled */
+    l_sreg = SREG_REG.byte;
+    cli();
+    for (i = 0; i < ULTRASONIC_RANGE_COUNT; i++) {
+        g_factors[i] = l_factors[i];
+    }
+    g_offsetMm = a_offsetMm;
+    g_offsetCm = (sint16) ((a_offsetMm + ((a_offsetMm < 0) ? -5 : 5)) / 10);
+    SREG_REG.byte = l_sreg;
+}
+
+/**
+ * @brief Gets the latest reading of a sensor of the array.
+ *
+ * @param a_sensor The sensor index (0 to ULTRASONIC_SENSOR_COUNT-1).
+ * @param a_distance Pointer that receives the distance in millimeters.
+ * @return TRUE if the reading is new since the previous call for this sensor.
+ */
+boolean Ultrasonic_getReading(uint8 a_sensor, uint16 *a_distance) {
+    boolean l_new;
+    uint8 l_sreg = SREG_REG.byte;
+
+    if (a_sensor >= ULTRASONIC_SENSOR_COUNT) {
+        *a_distance = ULTRASONIC_NO_ECHO_DISTANCE;
+        return FALSE;
+    }
+
+    /* The reading is written by the Timer0 tick, read it with interrupts disabled */
+    cli();
+    *a_distance = g_distanceMm[a_sensor];
+    l_new = BIT_IS_SET(g_newReadings, a_sensor) ? TRUE : FALSE;
+    CLEAR_BIT(g_newReadings, a_sensor);
+    SREG_REG.byte = l_sreg;
+
+    return l_new;
+}
+
+/**
+ * @brief Gets the nearest obstacle seen by the latest readings of the array.
+ *
+ * @param a_distance Pointer that receives the nearest distance in millimeters.
+ * @return The index of the sensor seeing the nearest obstacle, or ULTRASONIC_NO_SENSOR.
+ */
+uint8 Ultrasonic_getNearest(uint16 *a_distance) {
+    uint8 i;
+    uint8 l_nearest = ULTRASONIC_NO_SENSOR;
+    uint16 l_distance = ULTRASONIC_NO_ECHO_DISTANCE;
+    uint8 l_sreg = SREG_REG.byte;
+
+    cli();
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        if (g_distanceMm[i] < l_distance) {
+            l_distance = g_distanceMm[i];
+            l_nearest = i;
+        }
+    }
+    SREG_REG.byte = l_sreg;
+
+    *a_distance = l_distance;
+    return l_nearest;
+}
+
+/**
+ * @brief Gets the echo pulse of the latest reading of a sensor, before the distance conversion.
+ *
+ * @param a_sensor The sensor index (0 to ULTRASONIC_SENSOR_COUNT-1).
+ * @return The echo pulse width in Timer1 ticks, 0 when the echo timed out, the sensor was not
+ *         measured yet or does not exist.
+ */
+uint16 Ultrasonic_getEchoTicks(uint8 a_sensor) {
+    uint16 l_ticks;
+    uint8 l_sreg = SREG_REG.byte;
+
+    if (a_sensor >= ULTRASONIC_SENSOR_COUNT) {
+        return 0;
+    }
+
+    /* The ticks are written by the Timer0 tick, read both bytes with interrupts disabled */
+    cli();
+    l_ticks = g_echoTicks[a_sensor];
+    SREG_REG.byte = l_sreg;
+
+    return l_ticks;
+}
+
+/**
+ * @brief Takes the oldest measurements out of the sample ring, in the order they finished.
+ *
+ * The head is read once, so the batch is the samples published when the call starts. The slots
+ * are freed together by a single tail update after they are copied, and the distances are
+ * converted here, outside the interrupt, with the constants of the range of each sample.
+ *
+ * @param a_samples Array that receives the samples, oldest first.
+ * @param a_maxSamples Number of entries of the array.
+ * @return The number of samples written, 0 when the ring is empty.
+ */
+uint8 Ultrasonic_readSamples(Ultrasonic_SampleType *a_samples, uint8 a_maxSamples) {
+    uint8 l_tail = g_sampleTail;
+    uint8 l_count = (uint8) (g_sampleHead - l_tail);
+    uint8 i;
+    uint16 l_ticks;
+    volatile Ultrasonic_SampleType *l_slot;
+
+    if (l_count > a_maxSamples) {
+        l_count = a_maxSamples;
+    }
+
+    for (i = 0; i < l_count; i++) {
+        l_slot = &g_sampleRing[(uint8) (l_tail + i) & ULTRASONIC_SAMPLE_RING_MASK];
+        a_samples[i].timestamp = l_slot->timestamp;
+        a_samples[i].sensor = l_slot->sensor;
+        a_samples[i].range = l_slot->range;
+        a_samples[i].echo = l_slot->echo;
+        l_ticks = l_slot->echoTicks;
+        a_samples[i].distance = (l_ticks == 0) ? ULTRASONIC_NO_ECHO_DISTANCE :
+                Ultrasonic_ticksToMm(l_ticks, a_samples[i].range);
+        a_samples[i].echoTicks = Ultrasonic_referenceTicks(l_ticks, a_samples[i].range);
+    }
+    g_sampleTail = l_tail + l_count;                /**< Free the slots only after they are copied */
+
+    return l_count;
+}
+
+/**
+ * @brief Gets the number of measurements dropped because the sample ring was full.
+ *
+ * @return The dropped sample count since Ultrasonic_init(), saturated at 0xFFFF.
+ */
+uint16 Ultrasonic_getSampleOverflows(void) {
+    uint16 l_overflows;
+    uint8 l_sreg = SREG_REG.byte;
+
+    /* The counter is written by the ICU interrupts, read both bytes with interrupts disabled */
+    cli();
+    l_overflows = g_sampleOverflows;
+    SREG_REG.byte = l_sreg;
+
+    return l_overflows;
+}
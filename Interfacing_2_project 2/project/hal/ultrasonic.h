@@ -1,47 +1,373 @@
-/**
- * @file ultrasonic.h
- * @brief Ultrasonic Sensor Driver for measuring distance using ICU
- *
- * This file contains the function declarations for interfacing with an
- * ultrasonic sensor (e.g., HC-SR04) using the ICU (Input Capture Unit) of the AVR.
- *
- * @date 11 Oct 2024
- */
-
-#ifndef ULTRASONIC_H_
-#define ULTRASONIC_H_
-
-#include "../common/std_types.h"
-#define ULTRASONIC_TRIGGER_PIN  GPIO_PD7
-/**
- * @brief Initializes the Ultrasonic sensor.
- *
- * This function initializes the ICU, sets up the trigger pin, and configures the ultrasonic sensor.
- */
-void Ultrasonic_init(void);
-
-/**
- * @brief Triggers the Ultrasonic sensor to start a distance measurement.
- *
- * This function sends a trigger pulse to the ultrasonic sensor.
- */
-void Ultrasonic_Trigger(void);
-
-/**
- * @brief Reads the distance measured by the Ultrasonic sensor.
- *
- * This function calculates the distance based on the echo pulse duration and returns it.
- *
- * @return The measured distance in centimeters (cm).
- */
-uint16 Ultrasonic_readDistance(void);
-
-/**
- * @brief Callback function for ICU edge detection.
- *
- * This function is called by the ICU when an edge is detected (rising/falling) and
- * processes the echo pulse.
- */
-void Ultrasonic_edgeProcessing(void);
-
-#endif /* ULTRASONIC_H_ */
+/**
+ * @file ultrasonic.h
+ * @brief Ultrasonic Sensor Driver for measuring distance using ICU
+ *
+ * This file contains the function declarations for interfacing with an
+ * ultrasonic sensor (e.g., HC-SR04) using the ICU (Input Capture Unit) of the AVR.
+ *
+ * @date 11 Oct 2024
+ */
+
+#ifndef ULTRASONIC_H_
+#define ULTRASONIC_H_
+
+#include "../common/std_types.h"
+#include "../mcal/icu.h"
+#define ULTRASONIC_TRIGGER_PIN  GPIO_PD7
+
+/**
+ * @brief Number of sensors measured round-robin through the single ICU channel.
+ */
+#define ULTRASONIC_SENSOR_COUNT 1
+
+/**
+ * @brief Sensor descriptors, one initializer per sensor: { trigger pin, echo channel, guard time in ms }.
+ *
+ * All echo outputs reach ICP1 (PD6), either wired-OR through diodes, which works because only the
+ * triggered sensor answers, or through an analog multiplexer selected by the echo channel.
+ * A three sensor installation would use for example:
+ * { { GPIO_PD7, 0, ULTRASONIC_GUARD_MS }, { GPIO_PD5, 1, ULTRASONIC_GUARD_MS }, { GPIO_PD4, 2, ULTRASONIC_GUARD_MS } }
+ */
+#define ULTRASONIC_SENSORS { { ULTRASONIC_TRIGGER_PIN, 0, ULTRASONIC_GUARD_MS } }
+
+/**
+ *  @brief Echo multiplexer select pins.
+ *  if the echo outputs are routed through a multiplexer uncomment the macro definitions below, bit 0
+ *  and bit 1 of the echo channel are written to them before every ping. If they are wired-OR leave it as is
+ *
+#define ULTRASONIC_ECHO_SELECT_S0 GPIO_PB0
+#define ULTRASONIC_ECHO_SELECT_S1 GPIO_PB1
+**/
+
+/**
+ * @brief Default time in milliseconds after a measurement before the next sensor is triggered.
+ *
+ * Lets the late reflections of the previous ping die out so they are not taken for the next echo.
+ */
+#define ULTRASONIC_GUARD_MS 10
+
+/**
+ * @brief Minimum time in milliseconds between two pings of the same sensor (HC-SR04 measurement cycle).
+ */
+#define ULTRASONIC_MIN_CYCLE_MS 60
+
+/**
+ * @brief Period of the Timer0 tick running Ultrasonic_process() in milliseconds.
+ */
+#define ULTRASONIC_TICK_MS 1
+
+/**
+ * @brief Sensor index returned by Ultrasonic_getNearest() when no sensor sees an obstacle.
+ */
+#define ULTRASONIC_NO_SENSOR 0xFF
+
+/**
+ * @brief Clock of the far range ticks, the unit of all the echo ticks reported by the driver.
+ */
+#define ULTRASONIC_ICU_CLOCK F_CPU_8
+
+/**
+ * @brief Timer1 clock, never changed so that the ICU timestamps stay one timebase for every module.
+ *
+ * The echo is timed with the 32-bit capture timestamps and auto-ranged by its width: an echo
+ * whose 62.5 ns ticks (0.011 mm) fit 16 bits, up to 0.69 m, is converted with the near range
+ * constants, a wider one is reported in ULTRASONIC_ICU_CLOCK ticks with the far range ones.
+ */
+#define ULTRASONIC_TIMER_CLOCK F_CPU_CLOCK
+
+/**
+ * @brief Indices of the echo timer ranges, finest first.
+ */
+#define ULTRASONIC_NEAR_RANGE 0
+#define ULTRASONIC_FAR_RANGE 1
+#define ULTRASONIC_RANGE_COUNT 2
+
+/**
+ * @brief Right shift converting ULTRASONIC_TIMER_CLOCK ticks, the near range ones, to ULTRASONIC_ICU_CLOCK ticks.
+ */
+#define ULTRASONIC_NEAR_REFERENCE_SHIFT 3
+
+/**
+ * @brief Speed of sound in millimeters per second used for the conversion (340 m/s, about 15 C).
+ */
+#define ULTRASONIC_SPEED_OF_SOUND_MM_S 340000UL
+
+/**
+ * @brief Speed scale of Ultrasonic_setCalibration() keeping ULTRASONIC_SPEED_OF_SOUND_MM_S, 1.0 in Q15.
+ */
+#define ULTRASONIC_SPEED_SCALE_ONE 32768U
+
+/**
+ * @brief Distance travelled per echo timer tick of a Timer1 clock in a unit given per second, in fixed point.
+ *
+ * The echo covers the distance twice: distance = ticks * prescaler * speed / (2 * F_CPU).
+ * Evaluated at compile time and rounded, so the conversion is one multiplication and a shift.
+ */
+#define ULTRASONIC_CLOCK_TICK_FACTOR(clock, unitPerSecond, shift) \
+	((uint32) ((((unsigned long long) (unitPerSecond) * ICU_PRESCALER_VALUE(clock) \
+			<< (shift)) + F_CPU) / (2ULL * F_CPU)))
+
+/**
+ * @brief Distance travelled per ULTRASONIC_ICU_CLOCK tick in a unit given per second, in fixed point.
+ */
+#define ULTRASONIC_TICK_FACTOR(unitPerSecond, shift) \
+	ULTRASONIC_CLOCK_TICK_FACTOR(ULTRASONIC_ICU_CLOCK, unitPerSecond, shift)
+
+/**
+ * @brief Echo ticks of a Timer1 clock for a distance in millimeters, truncated.
+ */
+#define ULTRASONIC_MM_TO_TICKS(clock, mm) \
+	((uint32) (((unsigned long long) (mm) * 2ULL * F_CPU) \
+			/ ((unsigned long long) ULTRASONIC_SPEED_OF_SOUND_MM_S * ICU_PRESCALER_VALUE(clock))))
+
+/**
+ * @brief Fraction bits of the millimeter and centimeter factors.
+ *
+ * The largest shifts keeping the factors below 2^16 for the F_CPU_8 clock at 16 MHz, so a 16-bit
+ * tick count times the factor fits 32 bits. Lower them for a slower echo clock. The near range
+ * clock is ULTRASONIC_NEAR_REFERENCE_SHIFT times faster, so its factors take 3 more bits.
+ */
+#define ULTRASONIC_MM_SHIFT 19
+#define ULTRASONIC_CM_SHIFT 22
+#define ULTRASONIC_NEAR_MM_SHIFT (ULTRASONIC_MM_SHIFT + ULTRASONIC_NEAR_REFERENCE_SHIFT)
+#define ULTRASONIC_NEAR_CM_SHIFT (ULTRASONIC_CM_SHIFT + ULTRASONIC_NEAR_REFERENCE_SHIFT)
+
+/**
+ * @brief Millimeters and centimeters per echo timer tick in fixed point.
+ */
+#define ULTRASONIC_MM_PER_TICK ULTRASONIC_TICK_FACTOR(ULTRASONIC_SPEED_OF_SOUND_MM_S, ULTRASONIC_MM_SHIFT)
+#define ULTRASONIC_CM_PER_TICK ULTRASONIC_TICK_FACTOR(ULTRASONIC_SPEED_OF_SOUND_MM_S / 10, ULTRASONIC_CM_SHIFT)
+
+/**
+ * @brief ULTRASONIC_ICU_CLOCK ticks after the trigger or the echo rising edge after which a pending measurement is abandoned.
+ *
+ * Timer1 runs free, the elapsed time is checked on every overflow, so a lost echo is abandoned
+ * within one timer period of the limit (32.8 to 36.9 ms with the F_CPU_CLOCK). An echo wider
+ * than this limit (more than 5.5 m) is reported as a timeout too, whichever comes first.
+ */
+#define ULTRASONIC_TIMEOUT_TICKS 0x10000UL
+
+/**
+ * @brief Shortest distance the HC-SR04 measures in millimeters, a shorter echo is an out-of-range capture.
+ */
+#define ULTRASONIC_MIN_DISTANCE_MM 20
+
+/**
+ * @brief Distance returned by Ultrasonic_readDistance() and Ultrasonic_readDistanceMm() when the echo timed out.
+ *
+ * It is larger than any reachable distance so callers treat it as "nothing in range".
+ */
+#define ULTRASONIC_NO_ECHO_DISTANCE 0xFFFF
+
+/**
+ * @brief Number of samples the measurement sample ring holds, must be a power of two not above 128.
+ *
+ * One sample is pushed per finished measurement, so at the 60 ms minimum cycle 8 samples let the
+ * application fall almost half a second behind before samples are dropped.
+ */
+#define ULTRASONIC_SAMPLE_RING_SIZE 8
+
+/**
+ * @enum Ultrasonic_StatusType
+ * @brief Status of a measurement started by Ultrasonic_startMeasurement().
+ */
+typedef enum {
+    ULTRASONIC_IDLE,    /**< No measurement was started or its result was already collected. */
+    ULTRASONIC_PENDING, /**< The trigger was sent and the echo is still in flight. */
+    ULTRASONIC_READY,   /**< The echo was received and the distance is available. */
+    ULTRASONIC_TIMEOUT  /**< No complete echo was received within ULTRASONIC_TIMEOUT_TICKS. */
+} Ultrasonic_StatusType;
+
+/**
+ * @enum Ultrasonic_EchoType
+ * @brief What a finished measurement received, for the health statistics of the sensor.
+ */
+typedef enum {
+    ULTRASONIC_ECHO_VALID,       /**< An echo within the range of the sensor. */
+    ULTRASONIC_ECHO_NONE,        /**< An echo wider than the range (the HC-SR04 holds it 38 ms): nothing in range. */
+    ULTRASONIC_ECHO_LOST,        /**< No echo started within ULTRASONIC_TIMEOUT_TICKS of the trigger: the sensor did not answer. */
+    ULTRASONIC_ECHO_OUT_OF_RANGE /**< An echo shorter than ULTRASONIC_MIN_DISTANCE_MM: a glitch, not a distance. */
+} Ultrasonic_EchoType;
+
+/**
+ * @struct Ultrasonic_SensorType
+ * @brief Descriptor of one sensor of the array, see ULTRASONIC_SENSORS.
+ */
+typedef struct {
+    uint8 triggerPin;  /**< GPIO pin driving the TRIG input of the sensor. */
+    uint8 echoChannel; /**< Multiplexer channel routing the ECHO output to ICP1. */
+    uint8 guardMs;     /**< Quiet time after this sensor's measurement before the next ping. */
+} Ultrasonic_SensorType;
+
+/**
+ * @struct Ultrasonic_SampleType
+ * @brief One finished measurement read from the sample ring by Ultrasonic_readSamples().
+ */
+typedef struct {
+    uint32 timestamp;  /**< Timer0 timestamp (Timer0_getTimestamp()) of the echo falling edge or of the timeout. */
+    uint16 echoTicks;  /**< Echo pulse width in ULTRASONIC_ICU_CLOCK ticks, 0 unless the echo is valid. */
+    uint16 distance;   /**< Distance in millimeters, ULTRASONIC_NO_ECHO_DISTANCE unless the echo is valid. */
+    uint8 sensor;      /**< Index of the measured sensor (0 to ULTRASONIC_SENSOR_COUNT-1). */
+    uint8 range;       /**< Echo timer range that timed it, ULTRASONIC_NEAR_RANGE or ULTRASONIC_FAR_RANGE. */
+    uint8 echo;        /**< What the measurement received (Ultrasonic_EchoType). */
+} Ultrasonic_SampleType;
+
+/**
+ * @brief Initializes the Ultrasonic sensor.
+ *
+ * This function initializes the ICU, sets up the trigger pins, and registers Ultrasonic_process()
+ * on the Timer0 tick, so Timer0 must already be running (Scheduler_init).
+ */
+void Ultrasonic_init(void);
+
+/**
+ * @brief Triggers the Ultrasonic sensor to start a distance measurement.
+ *
+ * This function sends a trigger pulse to the current sensor of the round-robin.
+ */
+void Ultrasonic_Trigger(void);
+
+/**
+ * @brief Reads the distance measured by the Ultrasonic sensor.
+ *
+ * This function starts a measurement and waits until it completes or times out.
+ *
+ * @return The measured distance in centimeters (cm), or ULTRASONIC_NO_ECHO_DISTANCE on timeout.
+ */
+uint16 Ultrasonic_readDistance(void);
+
+/**
+ * @brief Reads the distance measured by the Ultrasonic sensor in millimeters.
+ *
+ * This function starts a measurement and waits until it completes or times out.
+ *
+ * @return The measured distance in millimeters (mm), or ULTRASONIC_NO_ECHO_DISTANCE on timeout.
+ */
+uint16 Ultrasonic_readDistanceMm(void);
+
+/**
+ * @brief Starts a distance measurement without waiting for the echo.
+ *
+ * This function sends the trigger pulse and arms the ICU and the Timer1 overflow timeout.
+ * The result is collected later with Ultrasonic_getResult(). Together with Ultrasonic_readDistance()
+ * it may only be used while the round-robin is stopped by Ultrasonic_setPingInterval(0).
+ */
+void Ultrasonic_startMeasurement(void);
+
+/**
+ * @brief Polls the measurement started by Ultrasonic_startMeasurement().
+ *
+ * A READY or TIMEOUT status is reported once, after which the status returns to IDLE.
+ *
+ * @param a_distance Pointer that receives the distance in centimeters when READY is returned.
+ * @return The status of the current measurement.
+ */
+Ultrasonic_StatusType Ultrasonic_getResult(uint16 *a_distance);
+
+/**
+ * @brief Polls the measurement started by Ultrasonic_startMeasurement() in millimeters.
+ *
+ * A READY or TIMEOUT status is reported once, after which the status returns to IDLE.
+ *
+ * @param a_distance Pointer that receives the distance in millimeters when READY is returned.
+ * @return The status of the current measurement.
+ */
+Ultrasonic_StatusType Ultrasonic_getResultMm(uint16 *a_distance);
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+/**
+ * @brief Callback function for ICU edge detection.
+ *
+ * This function is called by the ICU when an edge is detected (rising/falling) and
+ * processes the echo pulse. In ICU_DIRECT_CAPTURE_MODE the driver defines the capture vector instead.
+ */
+void Ultrasonic_edgeProcessing(void);
+#endif
+
+/**
+ * @brief Callback function for the Timer1 overflow.
+ *
+ * This function is called by the ICU driver when Timer1 wraps and aborts a measurement that
+ * has been pending for ULTRASONIC_TIMEOUT_TICKS.
+ */
+void Ultrasonic_overflowProcessing(void);
+
+/**
+ * @brief Runs the round-robin over the sensor array, called on every Timer0 tick.
+ *
+ * Once the ICU is done with a measurement, its result is stored for the measured sensor and the
+ * next sensor is triggered as soon as the guard time of the previous one expired and its own
+ * ping interval elapsed, so the ICU is kept busy without any call from the application.
+ */
+void Ultrasonic_process(void);
+
+/**
+ * @brief Sets the minimum time between two pings of the same sensor.
+ *
+ * @param a_intervalMs The ping interval in milliseconds, raised to ULTRASONIC_MIN_CYCLE_MS.
+ *                     0 stops the round-robin after the measurement in flight.
+ */
+void Ultrasonic_setPingInterval(uint16 a_intervalMs);
+
+/**
+ * @brief Gets the latest reading of a sensor of the array.
+ *
+ * @param a_sensor The sensor index (0 to ULTRASONIC_SENSOR_COUNT-1).
+ * @param a_distance Pointer that receives the distance in millimeters, ULTRASONIC_NO_ECHO_DISTANCE
+ *                   when the last echo timed out or the sensor was not measured yet.
+ * @return TRUE if the reading is new since the previous call for this sensor.
+ */
+boolean Ultrasonic_getReading(uint8 a_sensor, uint16 *a_distance);
+
+/**
+ * @brief Gets the nearest obstacle seen by the latest readings of the array.
+ *
+ * @param a_distance Pointer that receives the nearest distance in millimeters,
+ *                   ULTRASONIC_NO_ECHO_DISTANCE when no sensor sees an obstacle.
+ * @return The index of the sensor seeing the nearest obstacle, or ULTRASONIC_NO_SENSOR.
+ */
+uint8 Ultrasonic_getNearest(uint16 *a_distance);
+
+/**
+ * @brief Gets the echo pulse of the latest reading of a sensor, before the distance conversion.
+ *
+ * @param a_sensor The sensor index (0 to ULTRASONIC_SENSOR_COUNT-1).
+ * @return The echo pulse width in ULTRASONIC_ICU_CLOCK ticks whatever range timed it, 0 when the
+ *         echo timed out, the sensor was not measured yet or does not exist.
+ */
+uint16 Ultrasonic_getEchoTicks(uint8 a_sensor);
+
+/**
+ * @brief Regenerates the distance conversion for a calibrated speed of sound and distance offset.
+ *
+ * The millimeter and centimeter factors of every range are rescaled here once, so the conversion
+ * of a sample stays one multiplication and a shift. Call it when the calibration or the
+ * temperature changed, never per sample. Ultrasonic_init() starts with the uncalibrated values.
+ *
+ * @param a_speedScale Speed of sound relative to ULTRASONIC_SPEED_OF_SOUND_MM_S in Q15, below 2.0
+ *                     (ULTRASONIC_SPEED_SCALE_ONE is 1.0).
+ * @param a_offsetMm Millimeters added to every distance, a distance never goes below 0.
+ */
+void Ultrasonic_setCalibration(uint16 a_speedScale, sint16 a_offsetMm);
+
+/**
+ * @brief Takes the oldest measurements out of the sample ring, in the order they finished.
+ *
+ * The ICU interrupts push every measurement of the round-robin into the ring, so no reading is
+ * lost while the application is slower than the ping rate, up to ULTRASONIC_SAMPLE_RING_SIZE
+ * samples. The ring has a single consumer, only one caller may drain it.
+ *
+ * @param a_samples Array that receives the samples, oldest first.
+ * @param a_maxSamples Number of entries of the array.
+ * @return The number of samples written, 0 when the ring is empty.
+ */
+uint8 Ultrasonic_readSamples(Ultrasonic_SampleType *a_samples, uint8 a_maxSamples);
+
+/**
+ * @brief Gets the number of measurements dropped because the sample ring was full.
+ *
+ * @return The dropped sample count since Ultrasonic_init(), saturated at 0xFFFF.
+ */
+uint16 Ultrasonic_getSampleOverflows(void);
+
+#endif /* ULTRASONIC_H_ */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: adc.c
+ *
+ * Description: Source file for the AVR ADC driver (single conversions by polling)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "adc.h"
+#include "../common/common_macros.h"
+#include "atmega32_regs.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variable holding the reference selection bits of ADMUX, written again with every channel */
+static uint8 g_reference = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the ADC driver
+ * 	1. Set the required voltage reference, the result is right adjusted.
+ * 	2. Set the required ADC clock and enable the ADC, without interrupt.
+ */
+void ADC_init(const ADC_ConfigType *Config_Ptr) {
+	/* REFS1:0 in the two upper bits of ADMUX, ADLAR = 0 and channel 0 */
+	g_reference = (uint8) ((Config_Ptr->reference) << 6);
+	ADMUX_REG.byte = g_reference;
+
+	/*
+	 * insert the required clock value in the first three bits (ADPS0, ADPS1 and ADPS2)
+	 * of ADCSRA Register, no auto trigger and no interrupt
+	 */
+	ADCSRA_REG.byte = (Config_Ptr->prescaler) & 0x07;
+	ADCSRA_REG.bits.aden = LOGIC_HIGH;
+}
+
+/*
+ * Description: Function to convert the voltage of a single ended channel
+ *              Blocking, one conversion takes 13 ADC clocks (104 us at 125 kHz).
+ */
+uint16 ADC_readChannel(uint8 a_channel) {
+	/* Select the channel in MUX4:0, keeping the reference */
+	ADMUX_REG.byte = g_reference | (a_channel & (ADC_CHANNEL_COUNT - 1));
+
+	/* Start the conversion, ADSC is cleared by the hardware once the result is in ADC */
+	ADCSRA_REG.bits.adsc = LOGIC_HIGH;
+	while (ADCSRA_REG.bits.adsc);
+
+	return ADC_REG.value;
+}
+
+/*
+ * Description: Function to disable the ADC, it draws no current afterwards
+ */
+void ADC_deInit(void) {
+	ADCSRA_REG.byte = 0;
+	ADMUX_REG.byte = 0;
+}
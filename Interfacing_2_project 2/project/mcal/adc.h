@@ -0,0 +1,67 @@
+ /******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: adc.h
+ *
+ * Description: Header file for the AVR ADC driver (single conversions by polling)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Largest conversion result of the 10-bit ADC */
+#define ADC_MAXIMUM_VALUE 1023
+
+/* Number of single ended input channels, ADC0 to ADC7 on PA0 to PA7 */
+#define ADC_CHANNEL_COUNT 8
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+typedef enum
+{
+	ADC_AREF,ADC_AVCC,ADC_INTERNAL_2_56V=3
+}ADC_ReferenceType;
+
+typedef enum
+{
+	ADC_F_CPU_2=1,ADC_F_CPU_4,ADC_F_CPU_8,ADC_F_CPU_16,ADC_F_CPU_32,ADC_F_CPU_64,ADC_F_CPU_128
+}ADC_PrescalerType;
+
+typedef struct
+{
+	ADC_ReferenceType reference;
+	ADC_PrescalerType prescaler; /* The ADC clock must be between 50 kHz and 200 kHz for 10 bits */
+}ADC_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the ADC driver
+ * 	1. Set the required voltage reference, the result is right adjusted.
+ * 	2. Set the required ADC clock and enable the ADC, without interrupt.
+ */
+void ADC_init(const ADC_ConfigType * Config_Ptr);
+
+/*
+ * Description: Function to convert the voltage of a single ended channel
+ *              Blocking, one conversion takes 13 ADC clocks (104 us at 125 kHz).
+ */
+uint16 ADC_readChannel(uint8 a_channel);
+
+/*
+ * Description: Function to disable the ADC, it draws no current afterwards
+ */
+void ADC_deInit(void);
+
+#endif /* ADC_H_ */
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: eeprom.c
+ *
+ * Description: Source file for the AVR internal EEPROM driver
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "eeprom.h"
+#include "../common/common_macros.h"
+#include "atmega32_regs.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h> /* For cli() */
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description: Function to read one byte of the EEPROM
+ *              Waits for the completion of a write still in progress first.
+ */
+uint8 EEPROM_readByte(uint16 a_address) {
+	/* The address and data registers must not change while a write is in progress */
+	while (EECR_REG.bits.eewe);
+
+	/* Setup the address, the read strobe delivers the data in EEDR immediately */
+	EEAR_REG.word = a_address;
+	EECR_REG.bits.eere = LOGIC_HIGH;
+	return EEDR_REG.byte;
+}
+
+/*
+ * Description: Function to write one byte of the EEPROM
+ *              The write runs in the background for about 8.5 ms, the next access waits for it.
+ */
+void EEPROM_writeByte(uint16 a_address, uint8 a_data) {
+	uint8 l_sreg;
+
+	while (EECR_REG.bits.eewe);
+
+	EEAR_REG.word = a_address;
+	EEDR_REG.byte = a_data;
+
+	/*
+	 * EEWE must be set within four cycles after EEMWE, so both are set by two sbi instructions
+	 * with the interrupts disabled, whatever the optimization level of the build
+	 */
+	l_sreg = SREG_REG.byte;
+	cli();
+	__asm__ volatile (
+		"sbi %[eecr], %[eemwe]" "\n\t"
+		"sbi %[eecr], %[eewe]" "\n\t"
+		:
+		: [eecr] "I" (_SFR_IO_ADDR(EECR)), [eemwe] "I" (EEMWE), [eewe] "I" (EEWE)
+	);
+	SREG_REG.byte = l_sreg;
+}
+
+/*
+ * Description: Function to check that no write is in progress, so the next access does not wait
+ */
+boolean EEPROM_isReady(void) {
+	return !EECR_REG.bits.eewe;
+}
+
+/*
+ * Description: Function to read a block of bytes of the EEPROM into RAM
+ */
+void EEPROM_readBlock(uint16 a_address, uint8 *a_data, uint16 a_size) {
+	uint16 i;
+
+	for (i = 0; i < a_size; i++) {
+		a_data[i] = EEPROM_readByte(a_address + i);
+	}
+}
+
+/*
+ * Description: Function to write a block of bytes of RAM to the EEPROM
+ *              Only the bytes that differ are written, to save time and wear.
+ *              Blocking, about 8.5 ms per written byte.
+ */
+void EEPROM_updateBlock(uint16 a_address, const uint8 *a_data, uint16 a_size) {
+	uint16 i;
+
+	for (i = 0; i < a_size; i++) {
+		if (EEPROM_readByte(a_address + i) != a_data[i]) {
+			EEPROM_writeByte(a_address + i, a_data[i]);
+		}
+	}
+}
@@ -0,0 +1,59 @@
+ /******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: eeprom.h
+ *
+ * Description: Header file for the AVR internal EEPROM driver
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Size of the ATmega32 internal EEPROM in bytes */
+#define EEPROM_SIZE 1024
+
+/* Value of an erased EEPROM byte */
+#define EEPROM_ERASED_BYTE 0xFF
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description: Function to read one byte of the EEPROM
+ *              Waits for the completion of a write still in progress first.
+ */
+uint8 EEPROM_readByte(uint16 a_address);
+
+/*
+ * Description: Function to write one byte of the EEPROM
+ *              The write runs in the background for about 8.5 ms, the next access waits for it.
+ */
+void EEPROM_writeByte(uint16 a_address, uint8 a_data);
+
+/*
+ * Description: Function to check that no write is in progress, so the next access does not wait
+ */
+boolean EEPROM_isReady(void);
+
+/*
+ * Description: Function to read a block of bytes of the EEPROM into RAM
+ */
+void EEPROM_readBlock(uint16 a_address, uint8 *a_data, uint16 a_size);
+
+/*
+ * Description: Function to write a block of bytes of RAM to the EEPROM
+ *              Only the bytes that differ are written, to save time and wear.
+ *              Blocking, about 8.5 ms per written byte.
+ */
+void EEPROM_updateBlock(uint16 a_address, const uint8 *a_data, uint16 a_size);
+
+#endif /* EEPROM_H_ */
@@ -1,132 +1,252 @@
-/******************************************************************************
- *
- * Module: ICU
- *
- * File Name: icu.c
- *
- * Description: Source file for the AVR ICU driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-#include "icu.h"
-#include "../common/common_macros.h" /* To use the macros like SET_BIT */
-#include"atmega32_regs.h"
-
-#include <avr/interrupt.h> /* For ICU ISR */
-
-/*******************************************************************************
- *                           Global Variables                                  *
- *******************************************************************************/
-
-/* Global variables to hold the address of the call back function in the application */
-static volatile void (*g_callBackPtr)(void) = NULL_PTR;
-
-/*******************************************************************************
- *                       Interrupt Service Routines                            *
- *******************************************************************************/
-
-ISR(TIMER1_CAPT_vect) {
-	if (g_callBackPtr != NULL_PTR) {
-		/* Call the Call Back function in the application after the edge is detected */
-		(*g_callBackPtr)(); /* another method to call the function using pointer to function g_callBackPtr(); */
-	}
-}
-
-/*******************************************************************************
- *                      Functions Definitions                                  *
- *******************************************************************************/
-/*
- * Description : Function to initialize the ICU driver
- * 	1. Set the required clock.
- * 	2. Set the required edge detection.
- * 	3. Enable the Input Capture Interrupt.
- * 	4. Initialize Timer1 Registers
- */
-void ICU_init(const ICU_ConfigType *Config_Ptr) {
-	/* Configure ICP1/PD6 as i/p pin */
-
-	DDRD_REG.bits.ddd6 = LOGIC_LOW;
-	/* Timer1 always operates in Normal Mode */
-	TCCR1A_REG.bits.foc1a = LOGIC_HIGH;
-	TCCR1A_REG.bits.foc1b = LOGIC_HIGH;
-
-	/*
-	 * insert the required clock value in the first three bits (CS10, CS11 and CS12)
-	 * of TCCR1B Register
-	 */
-	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xF8) | (Config_Ptr->clock);
-
-	/*
-	 * insert the required edge type in ICES1 bit in TCCR1B Register
-	 */
-	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xBF) | ((Config_Ptr->edge) << 6);
-
-	/* Initial Value for Timer1 */
-	TCNT1_REG.word = 0;
-
-	/* Initial Value for the input capture register */
-	ICR1_REG.word = 0;
-
-	/* Enable the Input Capture interrupt to generate an interrupt when edge is detected on ICP1/PD6 pin */
-	TIMSK_REG.bits.ticie1 = LOGIC_HIGH;
-}
-
-/*
- * Description: Function to set the Call Back function address.
- */
-void ICU_setCallBack(void (*a_ptr)(void)) {
-	/* Save the address of the Call back function in a global variable */
-	g_callBackPtr = (volatile void*) a_ptr;
-}
-
-/*
- * Description: Function to set the required edge detection.
- */
-void ICU_setEdgeDetectionType(const ICU_EdgeType a_edgeType) {
-	/*
-	 * insert the required edge type in ICES1 bit in TCCR1B Register
-	 */
-	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xBF) | (a_edgeType << 6);
-}
-
-/*
- * Description: Function to get the Timer1 Value when the input is captured
- *              The value stored at Input Capture Register ICR1
- */
-uint16 ICU_getInputCaptureValue(void) {
-	return ICR1_REG.word;
-}
-
-/*
- * Description: Function to clear the Timer1 Value to start count from ZERO
- */
-void ICU_clearTimerValue(void) {
-	TCNT1_REG.word = 0;
-}
-
-/*
- * Description: Function to disable the Timer1 to stop the ICU Driver
- */
-void ICU_deInit(void) {
-	/* Clear All Timer1/ICU Registers */
-	TCCR1A_REG.byte = 0;
-	TCCR1B_REG.byte = 0;
-	TCNT1_REG.word = 0;
-	ICR1_REG.word = 0;
-
-	/* Disable the Input Capture interrupt */
-	TIMSK_REG.bits.ticie1 = LOGIC_LOW;
-
-	/* Reset the global pointer value */
-	g_callBackPtr = NULL_PTR;
-}
-void ICU_interruptOn() {
-	TIMSK_REG.bits.ticie1 = LOGIC_HIGH;
-
-}
-void ICU_interruptOff() {
-	TIMSK_REG.bits.ticie1 = LOGIC_HIGH;
-
-}
+/******************************************************************************
+ *
+ * Module: ICU
+ *
+ * File Name: icu.c
+ *
+ * Description: Source file for the AVR ICU driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#include "icu.h"
+#include "../common/common_macros.h" /* To use the macros like SET_BIT */
+#include"atmega32_regs.h"
+
+#include <avr/interrupt.h> /* For ICU ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variables to hold the address of the call back function in the application */
+static volatile void (*g_callBackPtr)(void) = NULL_PTR;
+
+/* Global variables to hold the address of the overflow call back function in the application */
+static volatile void (*g_overflowCallBackPtr)(void) = NULL_PTR;
+
+/* Global flag enabling the overflow call back, the overflow interrupt itself is always on */
+static volatile boolean g_overflowCallBackOn = FALSE;
+
+/* Global variable counting the Timer1 overflows, the high 16 bits of the timestamps, read by ICU_extendCapture */
+volatile uint16 g_icuTimerHigh = 0;
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+/* Global variable to hold the 32-bit timestamp of the last captured edge */
+static volatile uint32 g_captureTimestamp = 0;
+#endif
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+/* With ICU_DIRECT_CAPTURE_MODE the vector is defined by the driver owning the ICU, see ICU_CAPTURE_VECTOR */
+ISR(TIMER1_CAPT_vect) {
+	/* ICR1 was latched by the edge itself, the ISR latency only has to stay below the next edge */
+	uint16 l_capture = ICR1_REG.word;
+	uint16 l_high = g_icuTimerHigh;
+
+	/*
+	 * The overflow interrupt has a lower priority than the capture, a wrap just before the edge
+	 * may still be pending. A small capture value then belongs to the new period.
+	 */
+	if (TIFR_REG.bits.tov1 && (l_capture < ICU_HALF_RANGE)) {
+		l_high++;
+	}
+	g_captureTimestamp = ((uint32) l_high << 16) | l_capture;
+
+	if (g_callBackPtr != NULL_PTR) {
+		/* Call the Call Back function in the application after the edge is detected */
+		(*g_callBackPtr)(); /* another method to call the function using pointer to function g_callBackPtr(); */
+	}
+}
+#endif
+
+ISR(TIMER1_OVF_vect) {
+	/* Extend the timer to 32 bits before the application looks at the time */
+	g_icuTimerHigh++;
+
+	if (g_overflowCallBackOn && (g_overflowCallBackPtr != NULL_PTR)) {
+		/* Call the Call Back function in the application after Timer1 wraps around */
+		(*g_overflowCallBackPtr)();
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the ICU driver
+ * 	1. Set the required clock.
+ * 	2. Set the required edge detection.
+ * 	3. Enable the Input Capture Interrupt.
+ * 	4. Initialize Timer1 Registers
+ */
+void ICU_init(const ICU_ConfigType *Config_Ptr) {
+	/* Configure ICP1/PD6 as i/p pin */
+
+	DDRD_REG.bits.ddd6 = LOGIC_LOW;
+	/* Timer1 always operates in Normal Mode */
+	TCCR1A_REG.bits.foc1a = LOGIC_HIGH;
+	TCCR1A_REG.bits.foc1b = LOGIC_HIGH;
+
+	/*
+	 * insert the required clock value in the first three bits (CS10, CS11 and CS12)
+	 * of TCCR1B Register
+	 */
+	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xF8) | (Config_Ptr->clock);
+
+	/*
+	 * insert the required edge type in ICES1 bit in TCCR1B Register
+	 */
+	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xBF) | ((Config_Ptr->edge) << 6);
+
+	/* Initial Value for Timer1, it runs free from now on */
+	TCNT1_REG.word = 0;
+	g_icuTimerHigh = 0;
+
+	/* Initial Value for the input capture register */
+	ICR1_REG.word = 0;
+
+	/* Enable the Input Capture interrupt to generate an interrupt when edge is detected on ICP1/PD6 pin */
+	TIMSK_REG.bits.ticie1 = LOGIC_HIGH;
+
+	/* Enable the overflow interrupt counting the high bits of the timestamps, without call back yet */
+	g_overflowCallBackOn = FALSE;
+	TIFR_REG.byte = (1 << TOV1);
+	TIMSK_REG.bits.toie1 = LOGIC_HIGH;
+}
+
+/*
+ * Description: Function to set the Call Back function address.
+ */
+void ICU_setCallBack(void (*a_ptr)(void)) {
+	/* Save the address of the Call back function in a global variable */
+	g_callBackPtr = (volatile void*) a_ptr;
+}
+
+/*
+ * Description: Function to set the required edge detection.
+ */
+void ICU_setEdgeDetectionType(const ICU_EdgeType a_edgeType) {
+	/*
+	 * insert the required edge type in ICES1 bit in TCCR1B Register
+	 */
+	TCCR1B_REG.byte = (TCCR1B_REG.byte & 0xBF) | (a_edgeType << 6);
+}
+
+/*
+ * Description: Function to get the Timer1 Value when the input is captured
+ *              The value stored at Input Capture Register ICR1
+ */
+uint16 ICU_getInputCaptureValue(void) {
+	return ICR1_REG.word;
+}
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+/*
+ * Description: Function to get the 32-bit timestamp of the last captured edge, in Timer1 clocks
+ */
+uint32 ICU_getCaptureTimestamp(void) {
+	uint32 l_timestamp;
+	uint8 l_sreg = SREG_REG.byte;
+
+	/* The timestamp is written by the capture ISR, read the four bytes with interrupts disabled */
+	cli();
+	l_timestamp = g_captureTimestamp;
+	SREG_REG.byte = l_sreg;
+
+	return l_timestamp;
+}
+#endif
+
+/*
+ * Description: Function to get a free-running 32-bit timestamp in Timer1 clocks
+ *              The high word is the overflow count, TCNT1 the low word.
+ */
+uint32 ICU_getTimestamp(void) {
+	uint16 l_high;
+	uint16 l_count;
+	uint8 l_sreg = SREG_REG.byte;
+
+	cli();
+	l_high = g_icuTimerHigh;
+	l_count = TCNT1_REG.word;
+	if (TIFR_REG.bits.tov1 && (l_count < ICU_HALF_RANGE)) {
+		/* The wrap was not counted by the ISR yet */
+		l_high++;
+	}
+	SREG_REG.byte = l_sreg;
+
+	return ((uint32) l_high << 16) | l_count;
+}
+
+/*
+ * Description: Function to clear the Timer1 Value to start count from ZERO
+ */
+void ICU_clearTimerValue(void) {
+	TCNT1_REG.word = 0;
+}
+
+/*
+ * Description: Function to disable the Timer1 to stop the ICU Driver
+ */
+void ICU_deInit(void) {
+	/* Clear All Timer1/ICU Registers */
+	TCCR1A_REG.byte = 0;
+	TCCR1B_REG.byte = 0;
+	TCNT1_REG.word = 0;
+	ICR1_REG.word = 0;
+
+	/* Disable the Input Capture and overflow interrupts */
+	TIMSK_REG.bits.ticie1 = LOGIC_LOW;
+	TIMSK_REG.bits.toie1 = LOGIC_LOW;
+
+	/* Reset the global pointers value */
+	g_callBackPtr = NULL_PTR;
+	g_overflowCallBackPtr = NULL_PTR;
+	g_overflowCallBackOn = FALSE;
+}
+
+/*
+ * Description: Function to enable the Input Capture interrupt
+ *              Any edge captured while the interrupt was disabled is discarded
+ */
+void ICU_interruptOn() {
+	/* ICF1 is cleared by writing a logical one to it, a read-modify-write would clear the other flags too */
+	TIFR_REG.byte = (1 << ICF1);
+	TIMSK_REG.bits.ticie1 = LOGIC_HIGH;
+}
+
+/*
+ * Description: Function to disable the Input Capture interrupt
+ */
+void ICU_interruptOff() {
+	TIMSK_REG.bits.ticie1 = LOGIC_LOW;
+}
+
+/*
+ * Description: Function to set the Call Back function address that is called
+ *              when Timer1 overflows (TCNT1 wraps from 0xFFFF to 0)
+ */
+void ICU_setOverflowCallBack(void (*a_ptr)(void)) {
+	/* Save the address of the Call back function in a global variable */
+	g_overflowCallBackPtr = (volatile void*) a_ptr;
+}
+
+/*
+ * Description: Function to enable the call of the overflow Call Back function
+ *              TOV1 is left to the ISR, clearing it here would lose a count of the timestamps
+ */
+void ICU_overflowInterruptOn(void) {
+	g_overflowCallBackOn = TRUE;
+}
+
+/*
+ * Description: Function to disable the call of the overflow Call Back function
+ */
+void ICU_overflowInterruptOff(void) {
+	g_overflowCallBackOn = FALSE;
+}
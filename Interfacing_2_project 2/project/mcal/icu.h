@@ -1,77 +1,179 @@
- /******************************************************************************
- *
- * Module: ICU
- *
- * File Name: icu.h
- *
- * Description: Header file for the AVR ICU driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-#ifndef ICU_H_
-#define ICU_H_
-
-#include "../common/std_types.h"
-
-/*******************************************************************************
- *                         Types Declaration                                   *
- *******************************************************************************/
-typedef enum
-{
-	NO_CLOCK,F_CPU_CLOCK,F_CPU_8,F_CPU_64,F_CPU_256,F_CPU_1024
-}ICU_ClockType;
-
-typedef enum
-{
-	FALLING,RAISING
-}ICU_EdgeType;
-
-typedef struct
-{
-	ICU_ClockType clock;
-	ICU_EdgeType edge;
-}ICU_ConfigType;
-
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-/*
- * Description : Function to initialize the ICU driver
- * 	1. Set the required clock.
- * 	2. Set the required edge detection.
- * 	3. Enable the Input Capture Interrupt.
- * 	4. Initialize Timer1 Registers
- */
-void ICU_init(const ICU_ConfigType * Config_Ptr);
-
-/*
- * Description: Function to set the Call Back function address.
- */
-void ICU_setCallBack(void(*a_ptr)(void));
-
-/*
- * Description: Function to set the required edge detection.
- */
-void ICU_setEdgeDetectionType(const ICU_EdgeType edgeType);
-
-/*
- * Description: Function to get the Timer1 Value when the input is captured
- *              The value stored at Input Capture Register ICR1
- */
-uint16 ICU_getInputCaptureValue(void);
-
-/*
- * Description: Function to clear the Timer1 Value to start count from ZERO
- */
-void ICU_clearTimerValue(void);
-
-/*
- * Description: Function to disable the Timer1 to stop the ICU Driver
- */
-void ICU_deInit(void);
-void ICU_interruptOn();
-void ICU_interruptOff();
-typedef enum {OFF,ON}INTERUPT_STATE;
-#endif /* ICU_H_ */
+ /******************************************************************************
+ *
+ * Module: ICU
+ *
+ * File Name: icu.h
+ *
+ * Description: Header file for the AVR ICU driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#ifndef ICU_H_
+#define ICU_H_
+
+#include "../common/std_types.h"
+#include "atmega32_regs.h"
+#include <avr/interrupt.h> /* For ISR() in ICU_CAPTURE_VECTOR */
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+typedef enum
+{
+	NO_CLOCK,F_CPU_CLOCK,F_CPU_8,F_CPU_64,F_CPU_256,F_CPU_1024
+}ICU_ClockType;
+
+typedef enum
+{
+	FALLING,RAISING
+}ICU_EdgeType;
+
+typedef struct
+{
+	ICU_ClockType clock;
+	ICU_EdgeType edge;
+}ICU_ConfigType;
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Direct capture binding: the driver owning the ICU defines the input capture vector in its own
+ * file with ICU_CAPTURE_VECTOR(), so the compiler inlines its handler into the vector at any
+ * optimization level, without link time optimization, and there is no call through a pointer.
+ * The vector reads ICR1 first and hands it to the handler, which extends it to 32 bits with
+ * ICU_extendCapture(). The ICU driver then defines no capture vector and ICU_setCallBack is unused.
+ * Comment the macro definition below to go back to the call back pointer.
+ */
+#define ICU_DIRECT_CAPTURE_MODE
+
+/* Half of the Timer1 range, a count below this just after a pending wrap belongs to the new period */
+#define ICU_HALF_RANGE 0x8000
+
+/* Timer1 clock divisor selected by an ICU_ClockType value, a constant expression for constant clocks */
+#define ICU_PRESCALER_VALUE(clock) \
+	((clock) == F_CPU_CLOCK ? 1UL : \
+	 (clock) == F_CPU_8 ? 8UL : \
+	 (clock) == F_CPU_64 ? 64UL : \
+	 (clock) == F_CPU_256 ? 256UL : \
+	 (clock) == F_CPU_1024 ? 1024UL : 0UL)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the ICU driver
+ * 	1. Set the required clock.
+ * 	2. Set the required edge detection.
+ * 	3. Enable the Input Capture Interrupt.
+ * 	4. Initialize Timer1 Registers
+ * 	5. Enable the Timer1 overflow interrupt that extends the timer to 32 bits.
+ */
+void ICU_init(const ICU_ConfigType * Config_Ptr);
+
+/*
+ * Description: Function to set the Call Back function address.
+ */
+void ICU_setCallBack(void(*a_ptr)(void));
+
+#ifdef ICU_DIRECT_CAPTURE_MODE
+/* Timer1 overflow count, the high word of the timestamps, counted by the ICU driver */
+extern volatile uint16 g_icuTimerHigh;
+
+/*
+ * Description: Defines the input capture vector, calling a_handler with the value of ICR1
+ *              To be used once, by the driver owning the ICU, with a handler of the same file
+ *              declared always inline: void handler(uint16 a_capture).
+ */
+#define ICU_CAPTURE_VECTOR(a_handler) \
+	ISR(TIMER1_CAPT_vect) { \
+		a_handler(ICR1_REG.word); \
+	}
+
+/*
+ * Description: Function to extend the ICR1 value of the capture vector running to a 32-bit timestamp
+ *              The overflow interrupt has a lower priority than the capture, a wrap just before the
+ *              edge may still be pending: a small capture value then belongs to the new period.
+ *              Only valid within the capture vector, inlined so the vector makes no call for it.
+ */
+static inline __attribute__((always_inline)) uint32 ICU_extendCapture(uint16 a_capture) {
+	uint16 l_high = g_icuTimerHigh;
+
+	if (TIFR_REG.bits.tov1 && (a_capture < ICU_HALF_RANGE)) {
+		l_high++;
+	}
+	return ((uint32) l_high << 16) | a_capture;
+}
+#endif
+
+/*
+ * Description: Function to set the required edge detection.
+ */
+void ICU_setEdgeDetectionType(const ICU_EdgeType edgeType);
+
+/*
+ * Description: Function to get the Timer1 Value when the input is captured
+ *              The value stored at Input Capture Register ICR1
+ */
+uint16 ICU_getInputCaptureValue(void);
+
+#ifndef ICU_DIRECT_CAPTURE_MODE
+/*
+ * Description: Function to get the 32-bit timestamp of the last captured edge, in Timer1 clocks
+ *              The overflow count extends ICR1, including a wrap that happened just before the capture
+ *              and is not counted yet. Valid in the capture callback and until the next capture.
+ */
+uint32 ICU_getCaptureTimestamp(void);
+#endif
+
+/*
+ * Description: Function to get a free-running 32-bit timestamp in Timer1 clocks
+ *              Timer1 is never cleared and its clock is only set by ICU_init, so it is a timebase
+ *              that can be shared: differences are valid across wrap-around (268 s at F_CPU).
+ *              It can be called from any context.
+ */
+uint32 ICU_getTimestamp(void);
+
+/*
+ * Description: Function to clear the Timer1 Value to start count from ZERO
+ *              The timestamps of the other users of Timer1 jump, prefer timestamp differences.
+ */
+void ICU_clearTimerValue(void);
+
+/*
+ * Description: Function to disable the Timer1 to stop the ICU Driver
+ */
+void ICU_deInit(void);
+
+/*
+ * Description: Function to enable the Input Capture interrupt
+ *              Any edge captured while the interrupt was disabled is discarded
+ */
+void ICU_interruptOn();
+
+/*
+ * Description: Function to disable the Input Capture interrupt
+ */
+void ICU_interruptOff();
+
+/*
+ * Description: Function to set the Call Back function address that is called
+ *              when Timer1 overflows (TCNT1 wraps from 0xFFFF to 0)
+ */
+void ICU_setOverflowCallBack(void(*a_ptr)(void));
+
+/*
+ * Description: Function to enable the call of the overflow Call Back function
+ *              The overflow interrupt itself always runs to extend the timestamps,
+ *              any overflow that happened while the call was disabled is not reported
+ */
+void ICU_overflowInterruptOn(void);
+
+/*
+ * Description: Function to disable the call of the overflow Call Back function
+ */
+void ICU_overflowInterruptOff(void);
+typedef enum {OFF,ON}INTERUPT_STATE;
+#endif /* ICU_H_ */
@@ -0,0 +1,149 @@
+/******************************************************************************
+ *
+ * Module: TIMER0
+ *
+ * File Name: timer0.c
+ *
+ * Description: Source file for the AVR Timer0 driver (CTC periodic tick)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "timer0.h"
+#include "../common/common_macros.h"
+#include "atmega32_regs.h"
+
+#include <avr/interrupt.h> /* For Timer0 ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global array to hold the addresses of the call back functions in the application */
+static void (*volatile g_callBackPtr[TIMER0_MAX_CALLBACKS])(void);
+
+/* Global variable to hold the number of registered call back functions */
+static volatile uint8 g_callBackCount = 0;
+
+/* Global variable to hold the number of compare matches since initialization */
+static volatile uint32 g_ticks = 0;
+
+/* Global variable to hold the number of timer clocks in one tick (compare value + 1) */
+static uint16 g_clocksPerTick = 256;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(TIMER0_COMP_vect) {
+	uint8 i;
+
+	g_ticks++;
+
+	/* Call the Call Back functions in the application on every tick */
+	for (i = 0; i < g_callBackCount; i++) {
+		(*g_callBackPtr[i])();
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the Timer0 driver
+ * 	1. Set the CTC mode and the required compare value.
+ * 	2. Set the required clock.
+ * 	3. Enable the Output Compare Match interrupt.
+ */
+void Timer0_init(const Timer0_ConfigType *Config_Ptr) {
+	/* Non PWM mode, CTC mode (WGM01 = 1, WGM00 = 0), OC0 disconnected */
+	TCCR0_REG.byte = 0;
+	TCCR0_REG.bits.foc0 = LOGIC_HIGH;
+	TCCR0_REG.bits.wgm01 = LOGIC_HIGH;
+
+	/* Initial Value for Timer0 and the required compare value */
+	TCNT0_REG.byte = 0;
+	OCR0_REG.byte = Config_Ptr->compareValue;
+	g_clocksPerTick = (uint16) Config_Ptr->compareValue + 1;
+
+	/*
+	 * insert the required clock value in the first three bits (CS00, CS01 and CS02)
+	 * of TCCR0 Register
+	 */
+	TCCR0_REG.byte = (TCCR0_REG.byte & 0xF8) | (Config_Ptr->clock);
+
+	/* Enable the Output Compare Match interrupt to generate an interrupt every tick */
+	TIMSK_REG.bits.ocie0 = LOGIC_HIGH;
+}
+
+/*
+ * Description: Function to add a Call Back function to be called on every tick.
+ *              Call backs run in interrupt context in the order they were added.
+ *              Returns FALSE if TIMER0_MAX_CALLBACKS functions were already added.
+ */
+boolean Timer0_addCallBack(void (*a_ptr)(void)) {
+	if (g_callBackCount >= TIMER0_MAX_CALLBACKS) {
+		return FALSE;
+	}
+
+	/* Store the pointer before publishing the new count, the ISR may run in between */
+	g_callBackPtr[g_callBackCount] = a_ptr;
+	g_callBackCount++;
+	return TRUE;
+}
+
+/*
+ * Description: Function to get the number of ticks since Timer0_init()
+ */
+uint32 Timer0_getTicks(void) {
+	uint32 l_ticks;
+	uint8 l_sreg = SREG_REG.byte;
+
+	/* The 32-bit counter is updated by the ISR, read it with interrupts disabled */
+	cli();
+	l_ticks = g_ticks;
+	SREG_REG.byte = l_sreg;
+
+	return l_ticks;
+}
+
+/*
+ * Description: Function to get a free-running timestamp in Timer0 clocks since Timer0_init()
+ *              It combines the tick count with TCNT0, so its resolution is one timer clock
+ *              (4 us with the F_CPU/64 clock at 16 MHz). Differences are valid across wrap-around.
+ */
+uint32 Timer0_getTimestamp(void) {
+	uint32 l_ticks;
+	uint8 l_count;
+	uint8 l_sreg = SREG_REG.byte;
+
+	cli();
+	l_ticks = g_ticks;
+	l_count = TCNT0_REG.byte;
+	if (TIFR_REG.bits.ocf0) {
+		/* The compare match was not counted by the ISR yet, TCNT0 has restarted from zero */
+		l_count = TCNT0_REG.byte;
+		l_ticks++;
+	}
+	SREG_REG.byte = l_sreg;
+
+	return l_ticks * g_clocksPerTick + l_count;
+}
+
+/*
+ * Description: Function to disable the Timer0 and remove all the Call Back functions
+ */
+void Timer0_deInit(void) {
+	/* Clear All Timer0 Registers */
+	TCCR0_REG.byte = 0;
+	TCNT0_REG.byte = 0;
+	OCR0_REG.byte = 0;
+
+	/* Disable the Output Compare Match interrupt */
+	TIMSK_REG.bits.ocie0 = LOGIC_LOW;
+
+	/* Reset the call back table */
+	g_callBackCount = 0;
+	g_ticks = 0;
+}
@@ -0,0 +1,78 @@
+ /******************************************************************************
+ *
+ * Module: TIMER0
+ *
+ * File Name: timer0.h
+ *
+ * Description: Header file for the AVR Timer0 driver (CTC periodic tick)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef TIMER0_H_
+#define TIMER0_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Maximum number of functions that can be called from the compare match interrupt.
+ * The scheduler, the ultrasonic round-robin, the LEDs and the LCD queue take four, the rest is
+ * headroom: Timer0_addCallBack() returns FALSE once the table is full, callers must check it.
+ */
+#define TIMER0_MAX_CALLBACKS 6
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+typedef enum
+{
+	TIMER0_NO_CLOCK,TIMER0_F_CPU_CLOCK,TIMER0_F_CPU_8,TIMER0_F_CPU_64,TIMER0_F_CPU_256,TIMER0_F_CPU_1024
+}Timer0_ClockType;
+
+typedef struct
+{
+	Timer0_ClockType clock;
+	uint8 compareValue; /* The tick period is (compareValue + 1) timer clocks */
+}Timer0_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the Timer0 driver
+ * 	1. Set the CTC mode and the required compare value.
+ * 	2. Set the required clock.
+ * 	3. Enable the Output Compare Match interrupt.
+ */
+void Timer0_init(const Timer0_ConfigType * Config_Ptr);
+
+/*
+ * Description: Function to add a Call Back function to be called on every tick.
+ *              Call backs run in interrupt context in the order they were added.
+ *              Returns FALSE if TIMER0_MAX_CALLBACKS functions were already added.
+ */
+boolean Timer0_addCallBack(void(*a_ptr)(void));
+
+/*
+ * Description: Function to get the number of ticks since Timer0_init()
+ */
+uint32 Timer0_getTicks(void);
+
+/*
+ * Description: Function to get a free-running timestamp in Timer0 clocks since Timer0_init()
+ *              It combines the tick count with TCNT0, so its resolution is one timer clock
+ *              (4 us with the F_CPU/64 clock at 16 MHz). Differences are valid across wrap-around.
+ */
+uint32 Timer0_getTimestamp(void);
+
+/*
+ * Description: Function to disable the Timer0 and remove all the Call Back functions
+ */
+void Timer0_deInit(void);
+
+#endif /* TIMER0_H_ */
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *
+ * Module: TIMER2
+ *
+ * File Name: timer2.c
+ *
+ * Description: Source file for the AVR Timer2 driver (CTC compare match interrupt)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "timer2.h"
+#include "../common/common_macros.h"
+#include "atmega32_regs.h"
+
+#include <avr/interrupt.h> /* For Timer2 ISR */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variable to hold the address of the call back function in the application */
+static void (*volatile g_callBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(TIMER2_COMP_vect) {
+	if (g_callBackPtr != NULL_PTR) {
+		/* Call the Call Back function in the application on every compare match */
+		(*g_callBackPtr)();
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the Timer2 driver
+ * 	1. Set the CTC mode and the required compare value.
+ * 	2. Set the required clock.
+ * 	3. Enable the Output Compare Match interrupt.
+ */
+void Timer2_init(const Timer2_ConfigType *Config_Ptr) {
+	/* Non PWM mode, CTC mode (WGM21 = 1, WGM20 = 0), OC2 disconnected */
+	TCCR2_REG.byte = 0;
+	TCCR2_REG.bits.foc2 = LOGIC_HIGH;
+	TCCR2_REG.bits.wgm21 = LOGIC_HIGH;
+
+	/* Initial Value for Timer2 and the required compare value */
+	TCNT2_REG.byte = 0;
+	OCR2_REG.byte = Config_Ptr->compareValue;
+
+	/*
+	 * insert the required clock value in the first three bits (CS20, CS21 and CS22)
+	 * of TCCR2 Register
+	 */
+	TCCR2_REG.byte = (TCCR2_REG.byte & 0xF8) | (Config_Ptr->clock);
+
+	/* Clear a stale compare match, then enable the Output Compare Match interrupt */
+	TIFR_REG.byte = (1 << OCF2);
+	TIMSK_REG.bits.ocie2 = LOGIC_HIGH;
+}
+
+/*
+ * Description: Function to set the Call Back function address called on every compare match.
+ */
+void Timer2_setCallBack(void (*a_ptr)(void)) {
+	/* Save the address of the Call back function in a global variable */
+	g_callBackPtr = a_ptr;
+}
+
+/*
+ * Description: Function to set the compare value of the next periods.
+ *              OCR2 is not buffered in CTC mode, the new value applies to the running period.
+ */
+void Timer2_setCompareValue(uint8 a_compareValue) {
+	OCR2_REG.byte = a_compareValue;
+}
+
+/*
+ * Description: Function to disable the Timer2
+ */
+void Timer2_deInit(void) {
+	/* Disable the Output Compare Match interrupt */
+	TIMSK_REG.bits.ocie2 = LOGIC_LOW;
+
+	/* Clear All Timer2 Registers */
+	TCCR2_REG.byte = 0;
+	TCNT2_REG.byte = 0;
+	OCR2_REG.byte = 0;
+}
@@ -0,0 +1,59 @@
+ /******************************************************************************
+ *
+ * Module: TIMER2
+ *
+ * File Name: timer2.h
+ *
+ * Description: Header file for the AVR Timer2 driver (CTC compare match interrupt)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef TIMER2_H_
+#define TIMER2_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+typedef enum
+{
+	TIMER2_NO_CLOCK,TIMER2_F_CPU_CLOCK,TIMER2_F_CPU_8,TIMER2_F_CPU_32,TIMER2_F_CPU_64,TIMER2_F_CPU_128,TIMER2_F_CPU_256,TIMER2_F_CPU_1024
+}Timer2_ClockType;
+
+typedef struct
+{
+	Timer2_ClockType clock;
+	uint8 compareValue; /* The compare match period is (compareValue + 1) timer clocks */
+}Timer2_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the Timer2 driver
+ * 	1. Set the CTC mode and the required compare value.
+ * 	2. Set the required clock.
+ * 	3. Enable the Output Compare Match interrupt.
+ */
+void Timer2_init(const Timer2_ConfigType * Config_Ptr);
+
+/*
+ * Description: Function to set the Call Back function address called on every compare match.
+ */
+void Timer2_setCallBack(void(*a_ptr)(void));
+
+/*
+ * Description: Function to set the compare value of the next periods.
+ *              Called from the compare match callback it sets the length of the period just started.
+ */
+void Timer2_setCompareValue(uint8 a_compareValue);
+
+/*
+ * Description: Function to disable the Timer2
+ */
+void Timer2_deInit(void);
+
+#endif /* TIMER2_H_ */
@@ -0,0 +1,202 @@
+/******************************************************************************
+ *
+ * Module: UART
+ *
+ * File Name: uart.c
+ *
+ * Description: Source file for the AVR USART driver (interrupt-driven transmit and receive ring buffers)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "uart.h"
+#include "atmega32_regs.h"
+
+#include <avr/interrupt.h> /* For the USART Data Register Empty and Receive Complete ISRs */
+
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) || (UART_TX_BUFFER_SIZE > 128)
+#error "UART_TX_BUFFER_SIZE must be a power of two up to 128"
+#endif
+
+#if (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) || (UART_RX_BUFFER_SIZE > 128)
+#error "UART_RX_BUFFER_SIZE must be a power of two up to 128"
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Transmit ring buffer, the indices run freely and are masked on access, volatile so the stores
+ * into the slots are never moved after the head update that publishes them to the ISR */
+static volatile uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+
+/* Index of the next byte to queue, only written by the main loop */
+static volatile uint8 g_txHead = 0;
+
+/* Index of the next byte to send, only written by the ISR */
+static volatile uint8 g_txTail = 0;
+
+/* Number of writes dropped because they did not fit */
+static uint16 g_dropCount = 0;
+
+/* Receive ring buffer, filled by the ISR and drained by UART_readByte(), volatile so the copy out
+ * of a slot is never moved after the tail update that frees it */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+
+/* Index of the next byte to receive, only written by the ISR */
+static volatile uint8 g_rxHead = 0;
+
+/* Index of the next byte to read, only written by the reader */
+static volatile uint8 g_rxTail = 0;
+
+/* Number of received bytes lost because the buffer was full */
+static volatile uint16 g_rxDropCount = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(USART_UDRE_vect) {
+	uint8 l_tail = g_txTail;
+
+	if (l_tail == g_txHead) {
+		/* Buffer empty, stop the interrupt until the next write */
+		UCSRB_REG.bits.udrie = LOGIC_LOW;
+		return;
+	}
+
+	UDR_REG.byte = g_txBuffer[l_tail & (UART_TX_BUFFER_SIZE - 1)];
+	g_txTail = l_tail + 1;
+}
+
+ISR(USART_RXC_vect) {
+	uint8 l_head = g_rxHead;
+	uint8 l_data = UDR_REG.byte; /* Reading UDR clears the interrupt */
+
+	if ((uint8) (l_head - g_rxTail) >= UART_RX_BUFFER_SIZE) {
+		/* Buffer full, keep the older bytes */
+		if (g_rxDropCount != 0xFFFF) {
+			g_rxDropCount++;
+		}
+		return;
+	}
+
+	g_rxBuffer[l_head & (UART_RX_BUFFER_SIZE - 1)] = l_data;
+	g_rxHead = l_head + 1;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the UART driver
+ * 	1. Set the frame format and the baud rate in double speed mode.
+ * 	2. Enable the transmitter, TXD (PD1) becomes an output.
+ * 	3. Enable the receiver and its Receive Complete interrupt, RXD (PD0) becomes an input.
+ */
+void UART_init(const UART_ConfigType *Config_Ptr) {
+	uint16 l_ubrr;
+
+	/* Double speed mode halves the baud rate error at the usual rates */
+	UCSRA_REG.byte = (1 << U2X);
+
+	/* The Data Register Empty interrupt is enabled by the writes, the receiver interrupts on every byte */
+	UCSRB_REG.byte = (1 << TXEN) | (1 << RXEN) | (1 << RXCIE);
+
+	/* URSEL selects UCSRC, 8 data bits (UCSZ1:0 = 11) */
+	UCSRC_REG.byte = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0) | ((Config_Ptr->parity) << UPM0)
+			| ((Config_Ptr->stopBits) << USBS);
+
+	/* Rounded to the nearest divisor, UBRRH shares its address with UCSRC and needs URSEL cleared */
+	l_ubrr = (uint16) (((F_CPU / 8UL) + (Config_Ptr->baudRate / 2)) / Config_Ptr->baudRate - 1);
+	UBRRH_REG.byte = (uint8) (l_ubrr >> 8) & 0x0F;
+	UBRRL_REG.byte = (uint8) l_ubrr;
+
+	g_txHead = 0;
+	g_txTail = 0;
+	g_rxHead = 0;
+	g_rxTail = 0;
+}
+
+/*
+ * Description: Function to queue bytes for transmission without waiting.
+ *              The bytes are queued all or none, returns FALSE and counts a drop when they do not fit.
+ *              Must only be called from one context (the main loop).
+ */
+boolean UART_write(const uint8 *a_data, uint8 a_length) {
+	uint8 i;
+	uint8 l_head = g_txHead;
+
+	if (a_length > UART_getTxFree()) {
+		g_dropCount++;
+		return FALSE;
+	}
+
+	for (i = 0; i < a_length; i++) {
+		g_txBuffer[(uint8) (l_head + i) & (UART_TX_BUFFER_SIZE - 1)] = a_data[i];
+	}
+
+	/* Publish the bytes before enabling the interrupt that sends them */
+	g_txHead = l_head + a_length;
+	UCSRB_REG.bits.udrie = LOGIC_HIGH;
+	return TRUE;
+}
+
+/*
+ * Description: Function to queue a null terminated string, all or none like UART_write().
+ */
+boolean UART_sendString(const char *a_str) {
+	uint8 l_length = 0;
+
+	while ((a_str[l_length] != '\0') && (l_length < UART_TX_BUFFER_SIZE)) {
+		l_length++;
+	}
+	return UART_write((const uint8 *) a_str, l_length);
+}
+
+/*
+ * Description: Function to get the number of free bytes in the transmit buffer.
+ */
+uint8 UART_getTxFree(void) {
+	/* One byte read of each index, the difference is valid across wrap-around */
+	return UART_TX_BUFFER_SIZE - (uint8) (g_txHead - g_txTail);
+}
+
+/*
+ * Description: Function to get the number of writes dropped because the buffer was full.
+ */
+uint16 UART_getDropCount(void) {
+	return g_dropCount;
+}
+
+/*
+ * Description: Function to take the oldest received byte without waiting.
+ *              Returns FALSE when no byte was received. Must only be called from one context.
+ */
+boolean UART_readByte(uint8 *a_data) {
+	uint8 l_tail = g_rxTail;
+
+	if (l_tail == g_rxHead) {
+		return FALSE;
+	}
+
+	*a_data = g_rxBuffer[l_tail & (UART_RX_BUFFER_SIZE - 1)];
+	/* Free the slot after the byte was copied out */
+	g_rxTail = l_tail + 1;
+	return TRUE;
+}
+
+/*
+ * Description: Function to get the number of received bytes lost because the receive buffer was full.
+ */
+uint16 UART_getRxDropCount(void) {
+	uint16 l_count;
+	uint8 l_sreg = SREG_REG.byte;
+
+	/* Written by the ISR, read both bytes with interrupts disabled */
+	cli();
+	l_count = g_rxDropCount;
+	SREG_REG.byte = l_sreg;
+	return l_count;
+}
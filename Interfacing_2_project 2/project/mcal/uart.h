@@ -0,0 +1,92 @@
+ /******************************************************************************
+ *
+ * Module: UART
+ *
+ * File Name: uart.h
+ *
+ * Description: Header file for the AVR USART driver (interrupt-driven transmit and receive ring buffers)
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef UART_H_
+#define UART_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Size of the transmit ring buffer, a power of two up to 128 */
+#define UART_TX_BUFFER_SIZE 128
+
+/* Size of the receive ring buffer, a power of two up to 128 */
+#define UART_RX_BUFFER_SIZE 32
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+typedef enum
+{
+	UART_PARITY_DISABLED,UART_PARITY_EVEN = 2,UART_PARITY_ODD
+}UART_ParityType;
+
+typedef enum
+{
+	UART_ONE_STOP_BIT,UART_TWO_STOP_BITS
+}UART_StopBitType;
+
+typedef struct
+{
+	uint32 baudRate; /* Frame format is 8 data bits with the parity and stop bits below */
+	UART_ParityType parity;
+	UART_StopBitType stopBits;
+}UART_ConfigType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description : Function to initialize the UART driver
+ * 	1. Set the frame format and the baud rate in double speed mode.
+ * 	2. Enable the transmitter, TXD (PD1) becomes an output.
+ * 	3. Enable the receiver and its Receive Complete interrupt, RXD (PD0) becomes an input.
+ */
+void UART_init(const UART_ConfigType * Config_Ptr);
+
+/*
+ * Description: Function to queue bytes for transmission without waiting.
+ *              The bytes are queued all or none, returns FALSE and counts a drop when they do not fit.
+ *              Must only be called from one context (the main loop).
+ */
+boolean UART_write(const uint8 * a_data, uint8 a_length);
+
+/*
+ * Description: Function to queue a null terminated string, all or none like UART_write().
+ */
+boolean UART_sendString(const char * a_str);
+
+/*
+ * Description: Function to get the number of free bytes in the transmit buffer.
+ */
+uint8 UART_getTxFree(void);
+
+/*
+ * Description: Function to get the number of writes dropped because the buffer was full.
+ */
+uint16 UART_getDropCount(void);
+
+/*
+ * Description: Function to take the oldest received byte without waiting.
+ *              Returns FALSE when no byte was received. Must only be called from one context.
+ */
+boolean UART_readByte(uint8 * a_data);
+
+/*
+ * Description: Function to get the number of received bytes lost because the receive buffer was full.
+ */
+uint16 UART_getRxDropCount(void);
+
+#endif /* UART_H_ */
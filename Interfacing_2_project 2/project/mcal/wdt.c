@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: wdt.c
+ *
+ * Description: Source file for the AVR watchdog timer driver
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#include "wdt.h"
+#include "../common/common_macros.h"
+#include "atmega32_regs.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h> /* For cli() */
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description: Function to start the watchdog with the required timeout
+ *              The MCU is reset unless WDT_reset() is called again within the timeout.
+ */
+void WDT_enable(WDT_TimeoutType a_timeout) {
+	uint8 l_sreg = SREG_REG.byte;
+
+	cli();
+	WDT_reset(); /* The new timeout starts from zero */
+
+	/* WDE with the prescaler in the first three bits (WDP0, WDP1 and WDP2), no timed sequence needed */
+	WDTCR_REG.byte = (uint8) ((1 << WDE) | (a_timeout & 0x07));
+	SREG_REG.byte = l_sreg;
+}
+
+/*
+ * Description: Function to restart the watchdog timeout
+ */
+void WDT_reset(void) {
+	__asm__ volatile ("wdr");
+}
+
+/*
+ * Description: Function to stop the watchdog with the timed WDTOE sequence
+ */
+void WDT_disable(void) {
+	uint8 l_sreg = SREG_REG.byte;
+
+	cli();
+	WDT_reset(); /* No timeout may expire during the sequence */
+
+	/*
+	 * WDE must be cleared within four cycles after WDTOE and WDE are set, so both writes are
+	 * two out instructions with the interrupts disabled, whatever the optimization level of the build
+	 */
+	__asm__ volatile (
+		"out %[wdtcr], %[enable]" "\n\t"
+		"out %[wdtcr], __zero_reg__" "\n\t"
+		:
+		: [wdtcr] "I" (_SFR_IO_ADDR(WDTCR)), [enable] "r" ((uint8) ((1 << WDTOE) | (1 << WDE)))
+	);
+	SREG_REG.byte = l_sreg;
+}
+
+/*
+ * Description: Function to check if the last reset of the MCU was caused by the watchdog
+ *              The reset flag is cleared, so only the first call after the reset returns TRUE.
+ */
+boolean WDT_causedReset(void) {
+	boolean l_watchdog = (boolean) MCUCSR_REG.bits.wdrf;
+
+	MCUCSR_REG.bits.wdrf = LOGIC_LOW; /* The flag is cleared by writing zero to it */
+	return l_watchdog;
+}
@@ -0,0 +1,52 @@
+ /******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: wdt.h
+ *
+ * Description: Header file for the AVR watchdog timer driver
+ *
+ * Author: Ibrahim Mohsen
+ *
+ *******************************************************************************/
+
+#ifndef WDT_H_
+#define WDT_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+/* Watchdog timeouts at 5 V, the watchdog runs on its own 1 MHz oscillator whatever F_CPU is */
+typedef enum
+{
+	WDT_16_MS,WDT_32_MS,WDT_65_MS,WDT_130_MS,WDT_260_MS,WDT_520_MS,WDT_1000_MS,WDT_2100_MS
+}WDT_TimeoutType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description: Function to start the watchdog with the required timeout
+ *              The MCU is reset unless WDT_reset() is called again within the timeout.
+ */
+void WDT_enable(WDT_TimeoutType a_timeout);
+
+/*
+ * Description: Function to restart the watchdog timeout
+ */
+void WDT_reset(void);
+
+/*
+ * Description: Function to stop the watchdog with the timed WDTOE sequence
+ */
+void WDT_disable(void);
+
+/*
+ * Description: Function to check if the last reset of the MCU was caused by the watchdog
+ *              The reset flag is cleared, so only the first call after the reset returns TRUE.
+ */
+boolean WDT_causedReset(void);
+
+#endif /* WDT_H_ */
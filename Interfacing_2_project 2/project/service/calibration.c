@@ -0,0 +1,178 @@
+/**
+ * @file calibration.c
+ * @brief Distance calibration and temperature compensation implementation.
+ *
+ * The speed of sound at the current temperature, relative to the one of the build, and the gain
+ * of the unit are combined into a single Q15 speed scale handed to Ultrasonic_setCalibration(),
+ * which rescales the fixed-point conversion factors of the echo timer ranges.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "calibration.h"
+#include "settings.h"
+#include "../hal/ultrasonic.h"
+#include "../mcal/adc.h"
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Lowest temperature of the thermistor table and the step between its entries, in 0.1 C.
+ */
+#define CALIBRATION_TABLE_FIRST_TEMPERATURE (-300)
+#define CALIBRATION_TABLE_STEP 100
+
+/**
+ * @brief Number of entries of the thermistor table, -30 C to 60 C.
+ */
+#define CALIBRATION_TABLE_SIZE 10
+
+/**
+ * @brief ADC reading of the thermistor divider every CALIBRATION_TABLE_STEP, stored in flash memory.
+ *
+ * Computed for the divider of CALIBRATION_THERMISTOR_CHANNEL with the AVCC reference, the
+ * readings fall as the temperature rises.
+ */
+static const uint16 g_thermistorTable[CALIBRATION_TABLE_SIZE] PROGMEM = {
+    974, 934, 873, 788, 684, 569, 456, 354, 270, 204
+};
+
+/**
+ * @brief Calibration in use.
+ */
+static Calibration_DataType g_calibration;
+
+/**
+ * @brief Temperature in 0.1 C the conversion factors were generated for.
+ */
+static sint16 g_temperature = CALIBRATION_REFERENCE_TEMPERATURE;
+
+/**
+ * @brief Reads the thermistor and converts the reading by linear interpolation in the table.
+ *
+ * @return The temperature in 0.1 C, limited to the range of the table.
+ */
+static sint16 Calibration_readTemperature(void) {
+    uint16 l_reading = 0;
+    uint16 l_upper;
+    uint16 l_lower;
+    uint8 i;
+
+    for (i = 0; i < CALIBRATION_ADC_SAMPLES; i++) {
+        l_reading += ADC_readChannel(CALIBRATION_THERMISTOR_CHANNEL);
+    }
+    l_reading /= CALIBRATION_ADC_SAMPLES;
+
+    l_upper = pgm_read_word(&g_thermistorTable[0]);
+    if (l_reading >= l_upper) {
+        return CALIBRATION_TABLE_FIRST_TEMPERATURE;
+    }
+    for (i = 1; i < CALIBRATION_TABLE_SIZE; i++) {
+        l_lower = pgm_read_word(&g_thermistorTable[i]);
+        if (l_reading >= l_lower) {
+            return (sint16) (CALIBRATION_TABLE_FIRST_TEMPERATURE + (sint16) (i - 1) * CALIBRATION_TABLE_STEP
+                    + (sint16) (((uint16) (l_upper - l_reading) * CALIBRATION_TABLE_STEP) / (l_upper - l_lower)));
+        }
+        l_upper = l_lower;
+    }
+    return CALIBRATION_TABLE_FIRST_TEMPERATURE + (CALIBRATION_TABLE_SIZE - 1) * CALIBRATION_TABLE_STEP;
+}
+
+/**
+ * @brief Regenerates the distance conversion for the calibration and g_temperature.
+ */
+static void Calibration_apply(void) {
+    uint32 l_scale = g_calibration.gain;
+    uint32 l_speed;
+
+    if (g_calibration.flags & CALIBRATION_FLAG_THERMISTOR) {
+        /* Speed of sound at the temperature relative to the one of the build, in Q15 */
+        l_speed = (uint32) (CALIBRATION_SPEED_AT_0C_CM_S + (CALIBRATION_SPEED_SLOPE * g_temperature) / 100);
+        l_speed = ((l_speed << 15) + (ULTRASONIC_SPEED_OF_SOUND_MM_S / 20)) / (ULTRASONIC_SPEED_OF_SOUND_MM_S / 10);
+        l_scale = ((l_scale * l_speed) + (1UL << 14)) >> 15;
+    }
+    if (l_scale > 0xFFFF) {
+        l_scale = 0xFFFF;
+    }
+    Ultrasonic_setCalibration((uint16) l_scale, g_calibration.offsetMm);
+}
+
+/**
+ * @brief Starts the calibration in g_calibration, with a first thermistor reading when it has one.
+ */
+static void Calibration_start(void) {
+    ADC_ConfigType l_adcConfig = { ADC_AVCC, ADC_F_CPU_128 };  /**< 125 kHz ADC clock at 16 MHz */
+
+    if (g_calibration.flags & CALIBRATION_FLAG_THERMISTOR) {
+        ADC_init(&l_adcConfig);
+        g_temperature = Calibration_readTemperature();
+    } else {
+        ADC_deInit();
+        g_temperature = CALIBRATION_REFERENCE_TEMPERATURE;
+    }
+    Calibration_apply();
+}
+
+/**
+ * @brief Loads the calibration from the EEPROM and applies it to the distance conversion.
+ */
+void Calibration_init(void) {
+    if (!Settings_load(SETTINGS_ADDRESS_CALIBRATION, CALIBRATION_MAGIC, (uint8 *) &g_calibration,
+            sizeof(g_calibration))) {
+        g_calibration.offsetMm = 0;
+        g_calibration.gain = CALIBRATION_GAIN_ONE;
+        g_calibration.flags = 0;
+    }
+
+    Calibration_start();
+}
+
+/**
+ * @brief Periodic task reading the thermistor.
+ *
+ * The factors follow the temperature in CALIBRATION_TEMPERATURE_STEP steps, a reading closer to
+ * the temperature they were generated for changes nothing.
+ */
+void Calibration_update(void) {
+    sint16 l_temperature;
+
+    if (!(g_calibration.flags & CALIBRATION_FLAG_THERMISTOR)) {
+        return;
+    }
+
+    l_temperature = Calibration_readTemperature();
+    if ((l_temperature >= g_temperature + CALIBRATION_TEMPERATURE_STEP)
+            || (l_temperature <= g_temperature - CALIBRATION_TEMPERATURE_STEP)) {
+        g_temperature = l_temperature;
+        Calibration_apply();
+    }
+}
+
+/**
+ * @brief Gets the calibration in use.
+ */
+void Calibration_get(Calibration_DataType *a_data) {
+    *a_data = g_calibration;
+}
+
+/**
+ * @brief Applies a new calibration and stores it in the EEPROM.
+ */
+boolean Calibration_set(const Calibration_DataType *a_data) {
+    if ((a_data->gain == 0) || (a_data->flags & ~CALIBRATION_FLAG_THERMISTOR)) {
+        return FALSE;
+    }
+
+    g_calibration = *a_data;
+    Calibration_start();
+    Settings_store(SETTINGS_ADDRESS_CALIBRATION, CALIBRATION_MAGIC, (const uint8 *) &g_calibration,
+            sizeof(g_calibration));
+    return TRUE;
+}
+
+/**
+ * @brief Gets the temperature the distance conversion was generated for.
+ */
+sint16 Calibration_getTemperature(void) {
+    return g_temperature;
+}
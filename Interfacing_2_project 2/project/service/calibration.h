@@ -0,0 +1,133 @@
+/**
+ * @file calibration.h
+ * @brief Distance calibration and temperature compensation interface.
+ *
+ * This file provides the declarations for the per-unit calibration of the distance conversion,
+ * a distance offset and a gain, kept in an EEPROM settings record, and for the optional compensation of the
+ * speed of sound with the temperature of an NTC thermistor read by the ADC. The ultrasonic
+ * conversion factors are regenerated only when the calibration is changed or the temperature has
+ * moved by CALIBRATION_TEMPERATURE_STEP, the measurements themselves never divide.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef CALIBRATION_H_
+#define CALIBRATION_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Magic number and layout version of the calibration settings record.
+ */
+#define CALIBRATION_MAGIC 0xCA01
+
+/**
+ * @brief Gain keeping the distances unchanged, 1.0 in Q15.
+ */
+#define CALIBRATION_GAIN_ONE 32768U
+
+/**
+ * @brief Calibration flag: an NTC thermistor is fitted and compensates the speed of sound.
+ */
+#define CALIBRATION_FLAG_THERMISTOR 0x01
+
+/**
+ * @brief ADC channel of the thermistor divider, ADC7 on PA7 which no other module uses.
+ *
+ * A 10 kOhm NTC (B = 3950) from PA7 to ground with a 10 kOhm resistor to AVCC. PA7 stays an input
+ * without pull-up, as after reset.
+ */
+#define CALIBRATION_THERMISTOR_CHANNEL 7
+
+/**
+ * @brief Conversions averaged for one temperature reading.
+ */
+#define CALIBRATION_ADC_SAMPLES 4
+
+/**
+ * @brief Temperature change in 0.1 C after which the conversion factors are regenerated.
+ *
+ * 0.5 C moves the speed of sound by 0.09 %, and the step doubles as a hysteresis against the
+ * noise of the readings.
+ */
+#define CALIBRATION_TEMPERATURE_STEP 5
+
+/**
+ * @brief Temperature in 0.1 C reported while no thermistor is fitted.
+ *
+ * About the temperature of ULTRASONIC_SPEED_OF_SOUND_MM_S, which is then used unchanged.
+ */
+#define CALIBRATION_REFERENCE_TEMPERATURE 144
+
+/**
+ * @brief Speed of sound in cm/s at 0 C and its change per 0.1 C in 0.01 cm/s, c = 331.3 + 0.606 T m/s.
+ */
+#define CALIBRATION_SPEED_AT_0C_CM_S 33130L
+#define CALIBRATION_SPEED_SLOPE 606L
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Calibration_DataType
+ * @brief Calibration of one unit, measured at installation against a known distance.
+ */
+typedef struct {
+    sint16 offsetMm; /**< Millimeters added to every distance, for the mounting depth of the sensor. */
+    uint16 gain;     /**< Scale of the distances in Q15 (CALIBRATION_GAIN_ONE is 1.0), below 2.0. */
+    uint8 flags;     /**< CALIBRATION_FLAG_ values. */
+} Calibration_DataType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Loads the calibration from the EEPROM and applies it to the distance conversion.
+ *
+ * An erased or corrupted record is replaced by the defaults: no offset, a gain of 1.0 and no
+ * thermistor. Must be called after Ultrasonic_init().
+ */
+void Calibration_init(void);
+
+/**
+ * @brief Periodic task reading the thermistor.
+ *
+ * Regenerates the conversion factors when the temperature moved by CALIBRATION_TEMPERATURE_STEP
+ * since they were last generated. Does nothing without thermistor. Blocks for the
+ * CALIBRATION_ADC_SAMPLES conversions, about 0.4 ms.
+ */
+void Calibration_update(void);
+
+/**
+ * @brief Gets the calibration in use.
+ *
+ * @param a_data Pointer that receives the calibration.
+ */
+void Calibration_get(Calibration_DataType *a_data);
+
+/**
+ * @brief Applies a new calibration and stores it in the EEPROM.
+ *
+ * A gain of 0 or an unknown flag is rejected and leaves the calibration in use unchanged.
+ * The EEPROM store is queued and written in the background, see Settings_store().
+ *
+ * @param a_data Pointer to the new calibration.
+ * @return TRUE if the calibration was applied.
+ */
+boolean Calibration_set(const Calibration_DataType *a_data);
+
+/**
+ * @brief Gets the temperature the distance conversion was generated for.
+ *
+ * @return The temperature in 0.1 C, CALIBRATION_REFERENCE_TEMPERATURE without thermistor.
+ */
+sint16 Calibration_getTemperature(void);
+
+#endif /* CALIBRATION_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file filter.c
+ * @brief Streaming distance filter implementation.
+ *
+ * The median keeps the window twice: a ring in arrival order to know which sample leaves, and
+ * an insertion-sorted copy to read the median. Replacing a sample shifts at most the whole
+ * window once, so no sort is run per sample.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "filter.h"
+
+/**
+ * @brief Replaces a sample of the sorted window, keeping it in ascending order.
+ *
+ * @param a_sorted The sorted window.
+ * @param a_count Number of samples in the window.
+ * @param a_old The sample leaving the window.
+ * @param a_new The sample entering the window.
+ */
+static void Filter_replaceSorted(uint16 *a_sorted, uint8 a_count, uint16 a_old, uint16 a_new) {
+    uint8 i = 0;
+
+    /* Find the leaving sample, any copy of an equal value will do */
+    while ((i < a_count - 1) && (a_sorted[i] != a_old)) {
+        i++;
+    }
+
+    /* Shift the neighbours over the freed slot until the new sample fits */
+    while ((i > 0) && (a_sorted[i - 1] > a_new)) {
+        a_sorted[i] = a_sorted[i - 1];
+        i--;
+    }
+    while ((i < a_count - 1) && (a_sorted[i + 1] < a_new)) {
+        a_sorted[i] = a_sorted[i + 1];
+        i++;
+    }
+    a_sorted[i] = a_new;
+}
+
+/**
+ * @brief Resets a filter to an empty window.
+ *
+ * @param a_state Pointer to the filter state.
+ */
+void Filter_init(Filter_StateType *a_state) {
+    a_state->head = 0;
+    a_state->count = 0;
+    a_state->average = 0;
+    a_state->averageValid = FALSE;
+}
+
+/**
+ * @brief Adds a sample to a filter and returns the filtered value.
+ *
+ * @param a_state Pointer to the filter state.
+ * @param a_sample The new sample.
+ * @return The filtered value, FILTER_NO_SAMPLE while the median of the window is FILTER_NO_SAMPLE.
+ */
+uint16 Filter_update(Filter_StateType *a_state, uint16 a_sample) {
+    uint8 i;
+    uint16 l_median;
+    uint16 l_average;
+
+    if (a_state->count < FILTER_MEDIAN_WINDOW) {
+        /* Window filling up: insertion step of an insertion sort */
+        i = a_state->count;
+        while ((i > 0) && (a_state->sorted[i - 1] > a_sample)) {
+            a_state->sorted[i] = a_state->sorted[i - 1];
+            i--;
+        }
+        a_state->sorted[i] = a_sample;
+        a_state->ring[a_state->count] = a_sample;
+        a_state->count++;
+    } else {
+        /* Window full: the oldest sample is overwritten by the new one */
+        Filter_replaceSorted(a_state->sorted, FILTER_MEDIAN_WINDOW, a_state->ring[a_state->head], a_sample);
+        a_state->ring[a_state->head] = a_sample;
+        a_state->head++;
+        if (a_state->head >= FILTER_MEDIAN_WINDOW) {
+            a_state->head = 0;
+        }
+    }
+    l_median = a_state->sorted[a_state->count >> 1];
+
+    if (l_median == FILTER_NO_SAMPLE) {
+        /* Nothing in range, restart the average from the next echo instead of ramping down from far away */
+        a_state->averageValid = FALSE;
+        return FILTER_NO_SAMPLE;
+    }
+
+    l_average = (uint16) (a_state->average >> FILTER_EMA_SHIFT);
+    if (!a_state->averageValid
+            || ((l_median > l_average) ? (l_median - l_average) : (l_average - l_median)) > FILTER_RESEED_MM) {
+        /* First echo, or a real move: follow the median at once, it only lags (N-1)/2 samples */
+        a_state->average = (uint32) l_median << FILTER_EMA_SHIFT;
+        a_state->averageValid = TRUE;
+    } else {
+        a_state->average = a_state->average - (a_state->average >> FILTER_EMA_SHIFT) + l_median;
+    }
+    return (uint16) (a_state->average >> FILTER_EMA_SHIFT);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file filter.h
+ * @brief Streaming distance filter interface.
+ *
+ * This file provides the declarations for a two stage filter applied to every distance sample
+ * before the state machine: a small-window running median that rejects single echo glitches,
+ * followed by an integer exponential moving average that smooths the remaining jitter and
+ * jumps to the median when the obstacle moved by more than the jitter.
+ * Each filtered stream keeps its own state in a fixed-size structure.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Number of samples of the running median, 3, 5 or 7.
+ *
+ * A window of N rejects up to (N-1)/2 consecutive glitches and delays steps by (N-1)/2 samples.
+ */
+#ifndef FILTER_MEDIAN_WINDOW
+#define FILTER_MEDIAN_WINDOW 5
+#endif
+
+/**
+ * @brief Smoothing of the moving average, each output moves 1/2^FILTER_EMA_SHIFT of the way to the median.
+ *
+ * An approach below FILTER_RESEED_MM per sample is followed with a lag of 2^FILTER_EMA_SHIFT - 1
+ * samples on top of the median, so the average stays light.
+ */
+#ifndef FILTER_EMA_SHIFT
+#define FILTER_EMA_SHIFT 1
+#endif
+
+/**
+ * @brief Difference in mm between the median and the average beyond which the average is reseeded.
+ *
+ * A median that moved this far is a real move of the obstacle, the median already rejected the
+ * glitches, so the average jumps to it instead of taking 2^FILTER_EMA_SHIFT samples per step to follow.
+ */
+#ifndef FILTER_RESEED_MM
+#define FILTER_RESEED_MM 30
+#endif
+
+/**
+ * @brief Sample value meaning "no echo", passed through unfiltered and restarting the average.
+ */
+#define FILTER_NO_SAMPLE 0xFFFF
+
+#if (FILTER_MEDIAN_WINDOW != 3) && (FILTER_MEDIAN_WINDOW != 5) && (FILTER_MEDIAN_WINDOW != 7)
+#error "FILTER_MEDIAN_WINDOW must be 3, 5 or 7"
+#endif
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Filter_StateType
+ * @brief State of one filtered stream.
+ */
+typedef struct {
+    uint16 ring[FILTER_MEDIAN_WINDOW];   /**< Samples of the window in arrival order. */
+    uint16 sorted[FILTER_MEDIAN_WINDOW]; /**< The same samples in ascending order. */
+    uint8 head;                          /**< Slot of the oldest sample in the ring. */
+    uint8 count;                         /**< Number of samples in the window (up to FILTER_MEDIAN_WINDOW). */
+    uint32 average;                      /**< Moving average scaled by 2^FILTER_EMA_SHIFT. */
+    boolean averageValid;                /**< FALSE until the average is seeded by a median. */
+} Filter_StateType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Resets a filter to an empty window.
+ *
+ * @param a_state Pointer to the filter state.
+ */
+void Filter_init(Filter_StateType *a_state);
+
+/**
+ * @brief Adds a sample to a filter and returns the filtered value.
+ *
+ * The cost is O(FILTER_MEDIAN_WINDOW) per sample: the oldest sample is removed from the sorted
+ * window and the new one inserted in place. While the window fills up, the median of the samples
+ * received so far is used.
+ *
+ * @param a_state Pointer to the filter state.
+ * @param a_sample The new sample.
+ * @return The filtered value, FILTER_NO_SAMPLE while the median of the window is FILTER_NO_SAMPLE.
+ */
+uint16 Filter_update(Filter_StateType *a_state, uint16 a_sample);
+
+#endif /* FILTER_H_ */
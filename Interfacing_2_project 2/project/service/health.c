@@ -0,0 +1,225 @@
+/**
+ * @file health.c
+ * @brief Watchdog supervision and sensor fault statistics implementation.
+ *
+ * Every measurement is classified as good or bad for its sensor. A single bad one is only
+ * counted, since the median filter already removes isolated glitches; only a run of
+ * HEALTH_FAULT_SAMPLES bad measurements declares the sensor faulty. A reading with no
+ * obstacle in range is a good measurement: the sensor answered.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "health.h"
+#include "scheduler.h"
+
+/**
+ * @brief Timer0 clocks per second with the F_CPU/64 scheduler clock, the unit of the sample timestamps.
+ */
+#define HEALTH_TIMER0_CLOCKS_PER_S (F_CPU / 64UL)
+
+/**
+ * @struct Health_SensorStateType
+ * @brief Statistics and fault detection state of one sensor.
+ */
+typedef struct {
+    Health_SensorStatsType stats; /**< Statistics reported by Health_getSensorStats(). */
+    uint8 badRun;                 /**< Consecutive bad measurements, up to HEALTH_FAULT_SAMPLES. */
+    uint8 goodRun;                /**< Consecutive good measurements while faulty. */
+    boolean silent;               /**< TRUE once the current silence was counted as a timeout. */
+    uint16 lastDistance;          /**< Previous valid reading in mm, ULTRASONIC_NO_ECHO_DISTANCE if none. */
+    uint32 lastTimestamp;         /**< Timer0 timestamp of the previous valid reading. */
+    uint32 lastSampleTicks;       /**< Scheduler tick of the previous measurement of any kind. */
+} Health_SensorStateType;
+
+/**
+ * @brief State of every sensor of the array.
+ */
+static Health_SensorStateType g_sensors[ULTRASONIC_SENSOR_COUNT];
+
+/**
+ * @brief TRUE if the last reset of the MCU was caused by the watchdog.
+ */
+static boolean g_watchdogReset = FALSE;
+
+/**
+ * @brief Increments a statistics count, saturated at 0xFFFF.
+ *
+ * @param a_count The count.
+ */
+static void Health_count(uint16 *a_count) {
+    if (*a_count != 0xFFFF) {
+        (*a_count)++;
+    }
+}
+
+/**
+ * @brief Moves the fault detection of a sensor by one good or bad measurement.
+ *
+ * @param a_sensor State of the sensor.
+ * @param a_good TRUE for a good measurement.
+ */
+static void Health_judge(Health_SensorStateType *a_sensor, boolean a_good) {
+    if (!a_good) {
+        a_sensor->goodRun = 0;
+        if (a_sensor->badRun < HEALTH_FAULT_SAMPLES) {
+            a_sensor->badRun++;
+        }
+        if (a_sensor->badRun >= HEALTH_FAULT_SAMPLES) {
+            a_sensor->stats.faulty = TRUE;
+        }
+    } else {
+        a_sensor->badRun = 0;
+        if (a_sensor->stats.faulty && (++a_sensor->goodRun >= HEALTH_RECOVERY_SAMPLES)) {
+            a_sensor->stats.faulty = FALSE;
+            a_sensor->goodRun = 0;
+        }
+    }
+}
+
+/**
+ * @brief Checks the cause of the last reset, then arms the watchdog.
+ */
+void Health_init(void) {
+    uint32 l_now = Scheduler_getTicks();
+    uint8 i;
+
+    g_watchdogReset = WDT_causedReset();
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        g_sensors[i].stats.timeouts = 0;
+        g_sensors[i].stats.outOfRange = 0;
+        g_sensors[i].stats.jumps = 0;
+        g_sensors[i].stats.faulty = FALSE;
+        g_sensors[i].badRun = 0;
+        g_sensors[i].goodRun = 0;
+        g_sensors[i].silent = FALSE;
+        g_sensors[i].lastDistance = ULTRASONIC_NO_ECHO_DISTANCE;
+        g_sensors[i].lastTimestamp = 0;
+        g_sensors[i].lastSampleTicks = l_now;
+    }
+    WDT_enable(HEALTH_WATCHDOG_TIMEOUT);
+}
+
+/**
+ * @brief Restarts the watchdog timeout.
+ *
+ * Kicked from the main loop only, never from an interrupt, so a task stuck in a loop or an
+ * interrupt storm starving the loop both let the watchdog reset the MCU.
+ */
+void Health_kickWatchdog(void) {
+    WDT_reset();
+}
+
+/**
+ * @brief Updates the statistics of the sensor of a measurement.
+ *
+ * A jump is judged against the previous valid reading of the sensor, at most one second old: an
+ * obstacle appearing in front of a sensor that saw nothing is not a jump. The reading after a
+ * jump is judged against the jumped one, so a real sudden change costs one count only, and the
+ * reading itself is kept for the filter that decides between the two.
+ *
+ * @param a_sample The measurement read from the sample ring.
+ * @return FALSE for an out-of-range capture, which must not enter the filter.
+ */
+boolean Health_checkSample(const Ultrasonic_SampleType *a_sample) {
+    Health_SensorStateType *l_sensor = &g_sensors[a_sample->sensor];
+    boolean l_good = TRUE;
+    boolean l_use = TRUE;
+    uint32 l_elapsed;
+    uint32 l_limit;
+    uint16 l_change;
+
+    l_sensor->lastSampleTicks = Scheduler_getTicks();
+    l_sensor->silent = FALSE;
+
+    switch (a_sample->echo) {
+    case ULTRASONIC_ECHO_LOST:
+        Health_count(&l_sensor->stats.timeouts);
+        l_sensor->lastDistance = ULTRASONIC_NO_ECHO_DISTANCE;
+        l_good = FALSE;
+        break;
+    case ULTRASONIC_ECHO_OUT_OF_RANGE:
+        Health_count(&l_sensor->stats.outOfRange);
+        l_good = FALSE;
+        l_use = FALSE;
+        break;
+    case ULTRASONIC_ECHO_VALID:
+        l_elapsed = a_sample->timestamp - l_sensor->lastTimestamp;
+        if ((l_sensor->lastDistance != ULTRASONIC_NO_ECHO_DISTANCE) && (l_elapsed <= HEALTH_TIMER0_CLOCKS_PER_S)) {
+            l_limit = HEALTH_JUMP_MARGIN_MM + (HEALTH_MAX_SPEED_MM_S * l_elapsed) / HEALTH_TIMER0_CLOCKS_PER_S;
+            l_change = (a_sample->distance > l_sensor->lastDistance)
+                    ? (a_sample->distance - l_sensor->lastDistance) : (l_sensor->lastDistance - a_sample->distance);
+            if (l_change > l_limit) {
+                Health_count(&l_sensor->stats.jumps);
+                l_good = FALSE;
+            }
+        }
+        l_sensor->lastDistance = a_sample->distance;
+        l_sensor->lastTimestamp = a_sample->timestamp;
+        break;
+    default:
+        l_sensor->lastDistance = ULTRASONIC_NO_ECHO_DISTANCE; /**< Nothing in range */
+        break;
+    }
+
+    Health_judge(l_sensor, l_good);
+    return l_use;
+}
+
+/**
+ * @brief Declares faulty the sensors that gave no measurement for HEALTH_SILENCE_MS.
+ *
+ * A silence counts as one timeout however long it lasts, and the sensor must then give
+ * HEALTH_RECOVERY_SAMPLES good measurements like after any other fault.
+ */
+void Health_update(void) {
+    uint32 l_now = Scheduler_getTicks();
+    uint8 i;
+
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        if (!g_sensors[i].silent
+                && ((l_now - g_sensors[i].lastSampleTicks) * SCHEDULER_TICK_MS >= HEALTH_SILENCE_MS)) {
+            g_sensors[i].silent = TRUE;
+            g_sensors[i].stats.faulty = TRUE;
+            g_sensors[i].goodRun = 0;
+            g_sensors[i].lastDistance = ULTRASONIC_NO_ECHO_DISTANCE;
+            Health_count(&g_sensors[i].stats.timeouts);
+        }
+    }
+}
+
+/**
+ * @brief Checks if any sensor of the array is declared faulty.
+ */
+boolean Health_isFaulty(void) {
+    return (boolean) ((Health_getFaultMask() & ~HEALTH_WATCHDOG_RESET_FLAG) != 0);
+}
+
+/**
+ * @brief Gets the fault mask: one bit per faulty sensor and HEALTH_WATCHDOG_RESET_FLAG.
+ */
+uint8 Health_getFaultMask(void) {
+    uint8 l_mask = g_watchdogReset ? HEALTH_WATCHDOG_RESET_FLAG : 0;
+    uint8 i;
+
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        if (g_sensors[i].stats.faulty) {
+            l_mask |= (uint8) (1 << i);
+        }
+    }
+    return l_mask;
+}
+
+/**
+ * @brief Gets the fault statistics of a sensor.
+ */
+void Health_getSensorStats(uint8 a_sensor, Health_SensorStatsType *a_stats) {
+    Health_SensorStatsType l_none = { 0 };
+
+    if (a_sensor >= ULTRASONIC_SENSOR_COUNT) {
+        *a_stats = l_none;
+        return;
+    }
+    *a_stats = g_sensors[a_sensor].stats;
+}
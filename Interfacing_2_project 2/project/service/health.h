@@ -0,0 +1,135 @@
+/**
+ * @file health.h
+ * @brief Watchdog supervision and sensor fault statistics interface.
+ *
+ * This file provides the declarations for arming the watchdog around the main loop and for the
+ * health statistics of every sensor of the array: lost echoes (timeouts), out-of-range captures
+ * and implausible jumps between two readings. A sensor that keeps failing is declared faulty, so
+ * the application can show the fault instead of acting on readings it cannot trust, and declared
+ * healthy again once it gives plausible readings for a while.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HEALTH_H_
+#define HEALTH_H_
+
+#include "../common/std_types.h"
+#include "../hal/ultrasonic.h"
+#include "../mcal/wdt.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Watchdog timeout, several times the longest run of the main loop between two kicks.
+ *
+ * No task waits for the EEPROM, the stores are written one byte per run of Settings_process().
+ */
+#define HEALTH_WATCHDOG_TIMEOUT WDT_520_MS
+
+/**
+ * @brief Fastest plausible speed of an obstacle towards or away from a sensor in mm/s.
+ */
+#define HEALTH_MAX_SPEED_MM_S 2000UL
+
+/**
+ * @brief Change in mm allowed between two readings on top of the speed, for the echo jitter.
+ */
+#define HEALTH_JUMP_MARGIN_MM 30
+
+/**
+ * @brief Consecutive bad measurements after which a sensor is declared faulty.
+ */
+#define HEALTH_FAULT_SAMPLES 8
+
+/**
+ * @brief Consecutive good measurements after which a faulty sensor is declared healthy again.
+ */
+#define HEALTH_RECOVERY_SAMPLES 8
+
+/**
+ * @brief Time without any measurement of a sensor after which it is declared faulty in ms.
+ *
+ * Well above the slowest ping interval of the application, so it only fires on a stalled sensor.
+ */
+#define HEALTH_SILENCE_MS 1000
+
+/**
+ * @brief Bit of the fault mask set after a watchdog reset, the lower bits are the faulty sensors.
+ */
+#define HEALTH_WATCHDOG_RESET_FLAG 0x80
+
+#if ULTRASONIC_SENSOR_COUNT > 7
+#error "The fault mask holds at most 7 sensors below HEALTH_WATCHDOG_RESET_FLAG"
+#endif
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Health_SensorStatsType
+ * @brief Fault statistics of one sensor since Health_init(), every count saturated at 0xFFFF.
+ */
+typedef struct {
+    uint16 timeouts;   /**< Measurements whose echo never started, and silences of the sensor. */
+    uint16 outOfRange; /**< Echoes shorter than ULTRASONIC_MIN_DISTANCE_MM. */
+    uint16 jumps;      /**< Readings farther from the previous one than an obstacle can move. */
+    boolean faulty;    /**< TRUE while the sensor is declared faulty. */
+} Health_SensorStatsType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Checks the cause of the last reset, then arms the watchdog with HEALTH_WATCHDOG_TIMEOUT.
+ *
+ * Must be called after Scheduler_init(), the silence of the sensors is timed with the Timer0 tick.
+ */
+void Health_init(void);
+
+/**
+ * @brief Restarts the watchdog timeout, called once per pass of the main loop.
+ */
+void Health_kickWatchdog(void);
+
+/**
+ * @brief Updates the statistics of the sensor of a measurement.
+ *
+ * @param a_sample The measurement read from the sample ring.
+ * @return FALSE if the reading must not enter the filter: an out-of-range capture.
+ */
+boolean Health_checkSample(const Ultrasonic_SampleType *a_sample);
+
+/**
+ * @brief Declares faulty the sensors that gave no measurement for HEALTH_SILENCE_MS.
+ */
+void Health_update(void);
+
+/**
+ * @brief Checks if any sensor of the array is declared faulty.
+ *
+ * @return TRUE if at least one sensor is faulty.
+ */
+boolean Health_isFaulty(void);
+
+/**
+ * @brief Gets the fault mask: one bit per faulty sensor and HEALTH_WATCHDOG_RESET_FLAG.
+ *
+ * @return The fault mask.
+ */
+uint8 Health_getFaultMask(void);
+
+/**
+ * @brief Gets the fault statistics of a sensor.
+ *
+ * @param a_sensor Index of the sensor (0 to ULTRASONIC_SENSOR_COUNT-1).
+ * @param a_stats Pointer that receives the statistics, all zero for a sensor that does not exist.
+ */
+void Health_getSensorStats(uint8 a_sensor, Health_SensorStatsType *a_stats);
+
+#endif /* HEALTH_H_ */
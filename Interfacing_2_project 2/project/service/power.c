@@ -0,0 +1,108 @@
+/**
+ * @file power.c
+ * @brief Idle sleep and power statistics implementation.
+ *
+ * Every sleep is timed with the Timer0 timestamp, the sub-millisecond remainder is carried over
+ * to the next sleep so that short sleeps between ticks still add up.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "power.h"
+#include "scheduler.h"
+#include "../mcal/timer0.h"
+#include "../mcal/atmega32_regs.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/**
+ * @brief Tick count at the start of the statistics.
+ */
+static uint32 g_startTicks = 0;
+
+/**
+ * @brief Whole milliseconds spent asleep.
+ */
+static uint32 g_sleepMs = 0;
+
+/**
+ * @brief Timer0 clocks spent asleep beyond g_sleepMs.
+ */
+static uint16 g_sleepClocks = 0;
+
+/**
+ * @brief Selects the idle sleep mode and starts the statistics.
+ */
+void Power_init(void) {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    Power_resetStats();
+}
+
+/**
+ * @brief Sleeps until the next interrupt.
+ *
+ * The instruction following sei() always runs before a pending interrupt is served, so the
+ * CPU enters sleep even when the interrupt is already pending and wakes on it at once.
+ */
+void Power_idle(void) {
+    uint32 l_start;
+    uint32 l_slept;
+
+    l_start = Timer0_getTimestamp();
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+    /* Served the waking interrupt, account the sleep without being interrupted halfway */
+    cli();
+    l_slept = Timer0_getTimestamp() - l_start + g_sleepClocks;
+    g_sleepMs += l_slept / POWER_TIMER0_CLOCKS_PER_MS;
+    g_sleepClocks = (uint16) (l_slept % POWER_TIMER0_CLOCKS_PER_MS);
+    sei();
+}
+
+/**
+ * @brief Gets the sleep statistics.
+ *
+ * @param a_stats Pointer that receives the statistics.
+ */
+void Power_getStats(Power_StatsType *a_stats) {
+    uint32 l_elapsed;
+    uint32 l_sleep;
+    uint8 l_sreg = SREG_REG.byte;
+
+    cli();
+    l_sleep = g_sleepMs;
+    SREG_REG.byte = l_sreg;
+    l_elapsed = (Scheduler_getTicks() - g_startTicks) * SCHEDULER_TICK_MS;
+
+    a_stats->elapsedMs = l_elapsed;
+    a_stats->sleepMs = l_sleep;
+
+    /* Scale both down so that the permille product fits in 32 bits */
+    while (l_elapsed > 0x3FFFFFUL) {
+        l_elapsed >>= 1;
+        l_sleep >>= 1;
+    }
+    if (l_sleep > l_elapsed) {
+        l_sleep = l_elapsed;  /**< A sleep still being accounted when the ticks were read */
+    }
+    a_stats->sleepPermille = (l_elapsed == 0) ? 0 : (uint16) ((l_sleep * 1000UL) / l_elapsed);
+    a_stats->averageCurrentUa = (uint16) (POWER_ACTIVE_CURRENT_UA
+            - ((POWER_ACTIVE_CURRENT_UA - POWER_IDLE_CURRENT_UA) * a_stats->sleepPermille) / 1000UL);
+}
+
+/**
+ * @brief Restarts the sleep statistics from now.
+ */
+void Power_resetStats(void) {
+    uint8 l_sreg = SREG_REG.byte;
+
+    cli();
+    g_startTicks = Scheduler_getTicks();
+    g_sleepMs = 0;
+    g_sleepClocks = 0;
+    SREG_REG.byte = l_sreg;
+}
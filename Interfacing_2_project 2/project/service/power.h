@@ -0,0 +1,87 @@
+/**
+ * @file power.h
+ * @brief Idle sleep and power statistics interface.
+ *
+ * This file provides the declarations for putting the MCU to sleep while the scheduler has no
+ * released task, and for the statistics of the time spent asleep. The idle sleep mode is used
+ * because the Timer0 tick and the ICU (Timer1) both run from the I/O clock, which the deeper
+ * sleep modes stop. The CPU is woken by the next interrupt, at the latest the next tick.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Typical supply current of the MCU while running, in microamperes.
+ *
+ * Datasheet order of magnitude for the ATmega32 at 16 MHz and 5 V, measure the board to refine it.
+ */
+#define POWER_ACTIVE_CURRENT_UA 12000UL
+
+/**
+ * @brief Typical supply current of the MCU in idle sleep, in microamperes.
+ */
+#define POWER_IDLE_CURRENT_UA 5000UL
+
+/**
+ * @brief Timer0 clocks in one millisecond with the F_CPU/64 scheduler clock.
+ */
+#define POWER_TIMER0_CLOCKS_PER_MS (F_CPU / 64000UL)
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Power_StatsType
+ * @brief Sleep statistics since Power_init() or the last Power_resetStats().
+ */
+typedef struct {
+    uint32 elapsedMs;        /**< Time covered by the statistics. */
+    uint32 sleepMs;          /**< Time spent in idle sleep. */
+    uint16 sleepPermille;    /**< Share of the time spent asleep in 1/1000. */
+    uint16 averageCurrentUa; /**< MCU current estimated from the sleep share and the typical currents. */
+} Power_StatsType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Selects the idle sleep mode and starts the statistics.
+ *
+ * Must be called after Scheduler_init(), the statistics are timed with the Timer0 tick.
+ */
+void Power_init(void);
+
+/**
+ * @brief Sleeps until the next interrupt.
+ *
+ * Must be called with interrupts disabled, after checking that there is nothing to run, so that
+ * an interrupt arriving after the check still wakes the CPU. Returns with interrupts enabled,
+ * once the interrupt that woke the CPU has been served.
+ */
+void Power_idle(void);
+
+/**
+ * @brief Gets the sleep statistics.
+ *
+ * @param a_stats Pointer that receives the statistics.
+ */
+void Power_getStats(Power_StatsType *a_stats);
+
+/**
+ * @brief Restarts the sleep statistics from now.
+ */
+void Power_resetStats(void);
+
+#endif /* POWER_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file probe.c
+ * @brief Execution time probes implementation.
+ *
+ * A probe entry is only written by the context that owns the probe, readers copy it with
+ * interrupts disabled so that a probe owned by an interrupt is never read halfway.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "probe.h"
+
+#ifdef PROBE_ENABLE
+
+#include "../mcal/atmega32_regs.h"
+#include <avr/interrupt.h>
+
+/**
+ * @brief Statistics of every probe indexed by Probe_IdType.
+ */
+static Probe_StatsType g_probes[PROBE_COUNT];
+
+/**
+ * @brief Records one run of a probe, called by PROBE_END().
+ *
+ * @param a_id The probe.
+ * @param a_clocks Duration of the run in Timer0 clocks.
+ */
+void Probe_record(uint8 a_id, uint32 a_clocks) {
+    Probe_StatsType *l_probe;
+
+    if (a_id >= PROBE_COUNT) {
+        return;
+    }
+    l_probe = &g_probes[a_id];
+
+    if ((l_probe->count == 0) || (a_clocks < l_probe->min)) {
+        l_probe->min = a_clocks;
+    }
+    if (a_clocks > l_probe->max) {
+        l_probe->max = a_clocks;
+    }
+    l_probe->total += a_clocks;
+    l_probe->count++;
+}
+
+/**
+ * @brief Gets the statistics of a probe.
+ *
+ * @param a_id The probe.
+ * @param a_stats Pointer that receives the statistics.
+ * @return FALSE if the probe does not exist.
+ */
+boolean Probe_getStats(uint8 a_id, Probe_StatsType *a_stats) {
+    uint8 l_sreg = SREG_REG.byte;
+
+    if (a_id >= PROBE_COUNT) {
+        return FALSE;
+    }
+
+    cli();
+    *a_stats = g_probes[a_id];
+    SREG_REG.byte = l_sreg;
+
+    if (a_stats->count == 0) {
+        a_stats->min = 0xFFFFFFFFUL;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Clears the statistics of all the probes.
+ */
+void Probe_reset(void) {
+    uint8 i;
+    uint8 l_sreg = SREG_REG.byte;
+
+    cli();
+    for (i = 0; i < PROBE_COUNT; i++) {
+        g_probes[i].count = 0;
+        g_probes[i].total = 0;
+        g_probes[i].min = 0;
+        g_probes[i].max = 0;
+    }
+    SREG_REG.byte = l_sreg;
+}
+
+#endif /* PROBE_ENABLE */
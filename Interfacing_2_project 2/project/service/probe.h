@@ -0,0 +1,119 @@
+/**
+ * @file probe.h
+ * @brief Execution time probes interface.
+ *
+ * This file provides begin/end macros that time a section of code with the free-running Timer0
+ * timestamp and accumulate the count, minimum, maximum and total per probe in a static table.
+ * Without PROBE_ENABLE the macros expand to nothing and the table is not compiled in.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef PROBE_H_
+#define PROBE_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Uncomment to compile the probes in.
+ *
+ * Each probe costs two timestamp reads and a table update, around 10 us at 16 MHz.
+ */
+/* #define PROBE_ENABLE */
+
+/**
+ * @brief CPU cycles per Timer0 clock with the F_CPU/64 scheduler clock, the probe resolution.
+ *
+ * Timer1 is not used: its clock changes with the echo range chosen by the ultrasonic driver.
+ */
+#define PROBE_CYCLES_PER_CLOCK 64UL
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @enum Probe_IdType
+ * @brief Probed sections, each recorded from a single context (main loop or one interrupt).
+ */
+typedef enum {
+    PROBE_SENSE_TASK,       /**< APP_senseTask(): filtering, state machine and ping rate. */
+    PROBE_STATE_MACHINE,    /**< StateMachineHandler() and the outputs of a transition. */
+    PROBE_DISPLAY_NORM,     /**< LCD_dispDataNorm(): formatting into the framebuffer. */
+    PROBE_LCD_FLUSH,        /**< LCD_flush(): framebuffer diff and queueing. */
+    PROBE_ALERT_LATENCY,    /**< Echo of the first raw reading within the danger distance to the danger alert. */
+    PROBE_COUNT             /**< Number of probes. */
+} Probe_IdType;
+
+/**
+ * @struct Probe_StatsType
+ * @brief Statistics of one probe, durations in Timer0 clocks (PROBE_CYCLES_PER_CLOCK cycles each).
+ */
+typedef struct {
+    uint32 count; /**< Number of recorded runs. */
+    uint32 total; /**< Sum of the durations, for the mean. */
+    uint32 min;   /**< Shortest duration, 0xFFFFFFFF before the first run. */
+    uint32 max;   /**< Longest duration. */
+} Probe_StatsType;
+
+/*******************************************************************************
+ *                                  Macros                                     *
+ *******************************************************************************/
+
+#ifdef PROBE_ENABLE
+
+#include "../mcal/timer0.h"
+
+/**
+ * @brief Starts timing the probe `id`, declares its start timestamp in the current block.
+ */
+#define PROBE_BEGIN(id) uint32 l_probeStart_##id = Timer0_getTimestamp()
+
+/**
+ * @brief Stops timing the probe `id` started in the same block and records the duration.
+ */
+#define PROBE_END(id) Probe_record((id), Timer0_getTimestamp() - l_probeStart_##id)
+
+#else
+
+#define PROBE_BEGIN(id)
+#define PROBE_END(id)
+
+#endif
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+#ifdef PROBE_ENABLE
+
+/**
+ * @brief Records one run of a probe, called by PROBE_END().
+ *
+ * @param a_id The probe.
+ * @param a_clocks Duration of the run in Timer0 clocks.
+ */
+void Probe_record(uint8 a_id, uint32 a_clocks);
+
+/**
+ * @brief Gets the statistics of a probe.
+ *
+ * @param a_id The probe.
+ * @param a_stats Pointer that receives the statistics.
+ * @return FALSE if the probe does not exist.
+ */
+boolean Probe_getStats(uint8 a_id, Probe_StatsType *a_stats);
+
+/**
+ * @brief Clears the statistics of all the probes.
+ */
+void Probe_reset(void);
+
+#endif
+
+#endif /* PROBE_H_ */
@@ -0,0 +1,125 @@
+/**
+ * @file scheduler.c
+ * @brief Cooperative time-triggered scheduler implementation.
+ *
+ * The Timer0 compare match interrupt only counts elapsed ticks. Scheduler_dispatch() consumes
+ * them from the main loop, updates the per-task release counters and runs the released tasks,
+ * so tasks never run in interrupt context and never preempt each other. Between ticks with
+ * nothing released the CPU sleeps in idle mode.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "scheduler.h"
+#include "power.h"
+#include "../mcal/timer0.h"
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Pointer to the task table in program memory.
+ */
+static const Scheduler_TaskType *g_tasks = NULL_PTR;
+
+/**
+ * @brief Number of entries in the task table.
+ */
+static uint8 g_taskCount = 0;
+
+/**
+ * @brief Ticks remaining until the next release of each task.
+ */
+static uint16 g_taskDelay[SCHEDULER_MAX_TASKS];
+
+/**
+ * @brief Ticks elapsed since the last Scheduler_dispatch(), incremented by the Timer0 interrupt.
+ */
+static volatile uint8 g_pendingTicks = 0;
+
+/**
+ * @brief Set once the tick is registered with Timer0.
+ */
+static boolean g_tickStarted = FALSE;
+
+/**
+ * @brief Timer0 tick callback, runs in interrupt context.
+ */
+static void Scheduler_tick(void) {
+    if (g_pendingTicks != 0xFF) {
+        g_pendingTicks++;
+    }
+}
+
+/**
+ * @brief Initializes the scheduler and starts the Timer0 tick.
+ *
+ * @param a_tasks Pointer to the task table stored in program memory (PROGMEM).
+ * @param a_count Number of entries in the table (at most SCHEDULER_MAX_TASKS).
+ */
+void Scheduler_init(const Scheduler_TaskType *a_tasks, uint8 a_count) {
+    Timer0_ConfigType timerConfig = { TIMER0_F_CPU_64, SCHEDULER_TIMER0_COMPARE }; /**< 1 tick per SCHEDULER_TICK_MS */
+    uint8 i;
+
+    if (a_count > SCHEDULER_MAX_TASKS) {
+        a_count = SCHEDULER_MAX_TASKS;
+    }
+    g_tasks = a_tasks;
+    g_taskCount = a_count;
+
+    /* Load the first release of every task from its offset */
+    for (i = 0; i < g_taskCount; i++) {
+        g_taskDelay[i] = pgm_read_word(&g_tasks[i].offset);
+    }
+
+    g_pendingTicks = 0;
+    Timer0_init(&timerConfig);
+    if (!g_tickStarted) {
+        g_tickStarted = Timer0_addCallBack(Scheduler_tick);
+    }
+    sei();
+}
+
+/**
+ * @brief Runs every task released since the previous call.
+ *
+ * A task is released when its remaining delay is not larger than the ticks elapsed since the
+ * previous dispatch, its delay is then reloaded with the period.
+ */
+void Scheduler_dispatch(void) {
+    uint8 l_elapsed;
+    uint8 i;
+
+    /* Take the elapsed ticks atomically, the interrupt may increment them meanwhile */
+    cli();
+    l_elapsed = g_pendingTicks;
+    g_pendingTicks = 0;
+
+    if (l_elapsed == 0) {
+#ifdef SCHEDULER_IDLE_SLEEP
+        Power_idle();  /**< Still atomic with the check, a tick arriving now wakes it at once */
+#else
+        sei();
+#endif
+        return;
+    }
+    sei();
+
+    for (i = 0; i < g_taskCount; i++) {
+        if (g_taskDelay[i] > l_elapsed) {
+            g_taskDelay[i] -= l_elapsed;
+        } else {
+            g_taskDelay[i] = pgm_read_word(&g_tasks[i].period);
+            ((void (*)(void)) pgm_read_ptr(&g_tasks[i].task))();
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of ticks since Scheduler_init().
+ *
+ * @return The tick count (wraps after 2^32 ticks).
+ */
+uint32 Scheduler_getTicks(void) {
+    return Timer0_getTicks();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file scheduler.h
+ * @brief Cooperative time-triggered scheduler interface.
+ *
+ * This file provides the declarations for a small cooperative scheduler driven by the
+ * Timer0 compare match tick. Tasks are described by a static table stored in program memory,
+ * each with its own period and offset, and are run to completion from the main loop.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Tick period of the scheduler in milliseconds.
+ *
+ * Task periods and offsets are expressed in ticks.
+ */
+#define SCHEDULER_TICK_MS 1
+
+/**
+ * @brief Timer0 compare value that produces one tick every SCHEDULER_TICK_MS with the F_CPU/64 clock.
+ *
+ * At 16 MHz this is 249, the value must fit in the 8-bit OCR0 register.
+ */
+#define SCHEDULER_TIMER0_COMPARE ((uint8) ((F_CPU / 64UL / 1000UL) * SCHEDULER_TICK_MS - 1))
+
+/**
+ * @brief Maximum number of tasks in the task table.
+ */
+#define SCHEDULER_MAX_TASKS 8
+
+/**
+ * @brief Put the MCU in idle sleep from Scheduler_dispatch() while no task is released.
+ *
+ * Comment out to keep the main loop polling, e.g. when measuring the dispatch latency.
+ */
+#define SCHEDULER_IDLE_SLEEP
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Scheduler_TaskType
+ * @brief Entry of the static task table.
+ *
+ * A task is first released `offset` ticks after Scheduler_init() and then every `period` ticks.
+ * Offsets are used to spread tasks with the same period over different ticks.
+ */
+typedef struct {
+    void (*task)(void); /**< Function run to completion when the task is released. */
+    uint16 period;      /**< Release period in ticks (must not be 0). */
+    uint16 offset;      /**< Ticks before the first release. */
+} Scheduler_TaskType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Initializes the scheduler and starts the Timer0 tick.
+ *
+ * @param a_tasks Pointer to the task table stored in program memory (PROGMEM).
+ * @param a_count Number of entries in the table (at most SCHEDULER_MAX_TASKS).
+ */
+void Scheduler_init(const Scheduler_TaskType *a_tasks, uint8 a_count);
+
+/**
+ * @brief Runs every task released since the previous call.
+ *
+ * This function should be called continuously from the main loop. When the main loop falls
+ * behind by more than one period, the missed releases of a task are dropped rather than queued.
+ * With SCHEDULER_IDLE_SLEEP, a call with no elapsed tick sleeps until the next interrupt.
+ */
+void Scheduler_dispatch(void);
+
+/**
+ * @brief Returns the number of ticks since Scheduler_init().
+ *
+ * @return The tick count (wraps after 2^32 ticks).
+ */
+uint32 Scheduler_getTicks(void);
+
+#endif /* SCHEDULER_H_ */
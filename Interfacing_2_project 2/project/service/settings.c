@@ -0,0 +1,145 @@
+/**
+ * @file settings.c
+ * @brief Persistent settings records in the EEPROM.
+ *
+ * The data is validated in place before it is copied to the caller, so a bad record never
+ * overwrites the defaults.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "settings.h"
+#include "../mcal/eeprom.h"
+
+/**
+ * @brief Largest data size of a record, the map reserves 16 bytes per record.
+ */
+#define SETTINGS_MAX_DATA_SIZE (16 - SETTINGS_RECORD_OVERHEAD)
+
+/**
+ * @struct Settings_PendingType
+ * @brief A record waiting to be written to the EEPROM.
+ */
+typedef struct {
+    uint16 address;                                                 /**< EEPROM address of the record */
+    uint8 size;                                                     /**< Bytes of the record, with the magic and checksum */
+    uint8 next;                                                     /**< Next byte to compare and write */
+    uint8 record[SETTINGS_MAX_DATA_SIZE + SETTINGS_RECORD_OVERHEAD];
+} Settings_PendingType;
+
+/**
+ * @brief Pending stores, the oldest first.
+ */
+static Settings_PendingType g_pending[SETTINGS_QUEUE_SIZE];
+
+/**
+ * @brief Number of pending stores.
+ */
+static uint8 g_pendingCount = 0;
+
+/**
+ * @brief Computes the checksum of the magic and data bytes of a record.
+ *
+ * @param a_record The record.
+ * @param a_size Number of bytes covered.
+ * @return The complement of their 8-bit sum.
+ */
+static uint8 Settings_checksum(const uint8 *a_record, uint8 a_size) {
+    uint8 l_sum = 0;
+    uint8 i;
+
+    for (i = 0; i < a_size; i++) {
+        l_sum += a_record[i];
+    }
+    return (uint8) ~l_sum;
+}
+
+/**
+ * @brief Loads a record from the EEPROM.
+ */
+boolean Settings_load(uint16 a_address, uint16 a_magic, uint8 *a_data, uint8 a_size) {
+    uint8 l_record[SETTINGS_MAX_DATA_SIZE + SETTINGS_RECORD_OVERHEAD];
+    uint8 i;
+
+    if (a_size > SETTINGS_MAX_DATA_SIZE) {
+        return FALSE;
+    }
+
+    EEPROM_readBlock(a_address, l_record, a_size + SETTINGS_RECORD_OVERHEAD);
+    if ((l_record[0] != (uint8) a_magic) || (l_record[1] != (uint8) (a_magic >> 8))
+            || (l_record[a_size + 2] != Settings_checksum(l_record, a_size + 2))) {
+        return FALSE;
+    }
+
+    for (i = 0; i < a_size; i++) {
+        a_data[i] = l_record[i + 2];
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Queues a record to be stored in the EEPROM.
+ */
+boolean Settings_store(uint16 a_address, uint16 a_magic, const uint8 *a_data, uint8 a_size) {
+    Settings_PendingType *l_pending;
+    uint8 i;
+
+    if (a_size > SETTINGS_MAX_DATA_SIZE) {
+        return FALSE;
+    }
+
+    /* A newer record replaces the pending one, its write starts over */
+    for (i = 0; (i < g_pendingCount) && (g_pending[i].address != a_address); i++) {
+    }
+    if (i == SETTINGS_QUEUE_SIZE) {
+        return FALSE;
+    }
+    l_pending = &g_pending[i];
+
+    l_pending->address = a_address;
+    l_pending->size = a_size + SETTINGS_RECORD_OVERHEAD;
+    l_pending->next = 0;
+    l_pending->record[0] = (uint8) a_magic;
+    l_pending->record[1] = (uint8) (a_magic >> 8);
+    for (i = 0; i < a_size; i++) {
+        l_pending->record[i + 2] = a_data[i];
+    }
+    l_pending->record[a_size + 2] = Settings_checksum(l_pending->record, a_size + 2);
+
+    if (l_pending == &g_pending[g_pendingCount]) {
+        g_pendingCount++;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Scheduler task writing the pending stores to the EEPROM.
+ */
+void Settings_process(void) {
+    Settings_PendingType *l_pending = &g_pending[0];
+    uint16 l_address;
+    uint8 i;
+
+    /* Reading would wait for the write in progress, come back on the next run */
+    if ((g_pendingCount == 0) || !EEPROM_isReady()) {
+        return;
+    }
+
+    /* The unchanged bytes are only read, a few cycles each */
+    while (l_pending->next < l_pending->size) {
+        l_address = l_pending->address + l_pending->next;
+        if (EEPROM_readByte(l_address) != l_pending->record[l_pending->next]) {
+            EEPROM_writeByte(l_address, l_pending->record[l_pending->next]);
+            l_pending->next++;
+            return;
+        }
+        l_pending->next++;
+    }
+
+    /* Record written, the next one moves to the head of the queue */
+    g_pendingCount--;
+    for (i = 0; i < g_pendingCount; i++) {
+        g_pending[i] = g_pending[i + 1];
+    }
+}
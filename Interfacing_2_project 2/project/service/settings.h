@@ -0,0 +1,82 @@
+/**
+ * @file settings.h
+ * @brief Persistent settings records in the EEPROM.
+ *
+ * This file provides the declarations for storing small configuration structures in the
+ * internal EEPROM, each in its own record at a fixed address of the map below:
+ * - magic (2), little endian: identifies the owner and the layout version of the record
+ * - data (size bytes)
+ * - checksum: complement of the 8-bit sum of the magic and data bytes
+ *
+ * An erased EEPROM, a record of an older layout or a corrupted one is never loaded, the owner
+ * then keeps its defaults. Stores are queued and written by Settings_process(), one byte per run,
+ * so no task waits for the EEPROM. A store cut short by a reset fails the checksum and is not loaded.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Bytes a record takes in the EEPROM beyond its data: the magic and the checksum.
+ */
+#define SETTINGS_RECORD_OVERHEAD 3
+
+/**
+ * @brief EEPROM map, 16 bytes per record.
+ */
+#define SETTINGS_ADDRESS_CALIBRATION 0x0000
+#define SETTINGS_ADDRESS_THRESHOLDS 0x0010
+
+/**
+ * @brief Number of stores that can be pending, one per record of the map.
+ */
+#define SETTINGS_QUEUE_SIZE 2
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Loads a record from the EEPROM.
+ *
+ * @param a_address EEPROM address of the record.
+ * @param a_magic Magic number the record must carry.
+ * @param a_data Buffer that receives the data, unchanged when the record is not valid.
+ * @param a_size Size of the data in bytes.
+ * @return TRUE if a valid record was loaded.
+ */
+boolean Settings_load(uint16 a_address, uint16 a_magic, uint8 *a_data, uint8 a_size);
+
+/**
+ * @brief Queues a record to be stored in the EEPROM.
+ *
+ * The record is copied, so the data may change once this returns. A store still pending for
+ * the same address is replaced. Settings_process() then writes only the bytes that changed,
+ * about 8.5 ms each.
+ *
+ * @param a_address EEPROM address of the record.
+ * @param a_magic Magic number of the record.
+ * @param a_data The data.
+ * @param a_size Size of the data in bytes.
+ * @return TRUE if the record was queued, FALSE if it is too large or the queue is full.
+ */
+boolean Settings_store(uint16 a_address, uint16 a_magic, const uint8 *a_data, uint8 a_size);
+
+/**
+ * @brief Scheduler task writing the pending stores to the EEPROM.
+ *
+ * Returns at once while the EEPROM is busy, otherwise starts the write of the next byte that
+ * changed. Run about every 10 ms, a 16-byte record is written within 0.2 s.
+ */
+void Settings_process(void);
+
+#endif /* SETTINGS_H_ */
@@ -0,0 +1,248 @@
+/**
+ * @file telemetry.c
+ * @brief Binary telemetry frames over the UART.
+ *
+ * The frame is built in a local buffer and handed to the UART in one all-or-none write, so a
+ * receiver never sees a partial frame, only missing ones. Received frames are parsed one byte at
+ * a time, the parser state is kept between the calls of Telemetry_poll().
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "telemetry.h"
+#include "power.h"
+#include "health.h"
+#include "scheduler.h"
+#include "../mcal/uart.h"
+
+/**
+ * @brief Steps of the receive parser, one per field of the frame.
+ */
+typedef enum {
+    TELEMETRY_RX_SYNC_1,
+    TELEMETRY_RX_SYNC_2,
+    TELEMETRY_RX_LENGTH,
+    TELEMETRY_RX_PAYLOAD,
+    TELEMETRY_RX_CHECKSUM
+} Telemetry_RxStepType;
+
+/**
+ * @brief Frames dropped since Telemetry_init().
+ */
+static uint16 g_dropCount = 0;
+
+/**
+ * @brief Sensor whose fault statistics go in the next frame.
+ */
+static uint8 g_healthSensor = 0;
+
+/**
+ * @brief Function handling the received commands.
+ */
+static void (*g_commandCallBack)(const uint8 *a_payload, uint8 a_length) = NULL_PTR;
+
+/**
+ * @brief Receive parser state: the field expected next, the payload so far and its running sum.
+ */
+static Telemetry_RxStepType g_rxStep = TELEMETRY_RX_SYNC_1;
+static uint8 g_rxPayload[TELEMETRY_COMMAND_MAX_PAYLOAD];
+static uint8 g_rxLength = 0;
+static uint8 g_rxIndex = 0;
+static uint8 g_rxSum = 0;
+
+/**
+ * @brief Appends a 16-bit value to a frame, least significant byte first.
+ *
+ * @param a_frame The frame.
+ * @param a_index Pointer to the next free index, advanced past the value.
+ * @param a_value The value.
+ */
+static void Telemetry_put16(uint8 *a_frame, uint8 *a_index, uint16 a_value) {
+    a_frame[(*a_index)++] = (uint8) a_value;
+    a_frame[(*a_index)++] = (uint8) (a_value >> 8);
+}
+
+/**
+ * @brief Initializes the UART for the telemetry link.
+ */
+void Telemetry_init(void) {
+    UART_ConfigType uartConfig = { TELEMETRY_BAUD_RATE, UART_PARITY_DISABLED, UART_ONE_STOP_BIT };
+
+    UART_init(&uartConfig);
+    g_dropCount = 0;
+    g_rxStep = TELEMETRY_RX_SYNC_1;
+}
+
+/**
+ * @brief Adds the checksum to a frame and queues it, counting the frames dropped.
+ *
+ * @param a_frame The frame from the sync bytes to the end of the payload.
+ * @param a_size Length of the frame so far, there must be room for the checksum.
+ * @return FALSE if the frame was dropped because the UART buffer was full.
+ */
+static boolean Telemetry_queueFrame(uint8 *a_frame, uint8 a_size) {
+    uint8 l_sum = 0;
+    uint8 i;
+
+    /* The checksum covers the length and the payload */
+    for (i = 2; i < a_size; i++) {
+        l_sum += a_frame[i];
+    }
+    a_frame[a_size++] = (uint8) ~l_sum;
+
+    if (!UART_write(a_frame, a_size)) {
+        if (g_dropCount != 0xFFFF) {
+            g_dropCount++;
+        }
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Builds a frame from the sample and the statistics and queues it without waiting.
+ *
+ * @param a_sample Pointer to the application values.
+ * @return FALSE if the frame was dropped because the UART buffer was full.
+ */
+boolean Telemetry_send(const Telemetry_SampleType *a_sample) {
+    uint8 l_frame[TELEMETRY_FRAME_SIZE];
+    uint8 l_index = 0;
+    uint32 l_time = Scheduler_getTicks() * SCHEDULER_TICK_MS;
+    Power_StatsType l_power;
+    Health_SensorStatsType l_health;
+#ifdef PROBE_ENABLE
+    Probe_StatsType l_probe;
+    uint32 l_mean;
+    uint8 i;
+#endif
+
+    Power_getStats(&l_power);
+    Health_getSensorStats(g_healthSensor, &l_health);
+
+    l_frame[l_index++] = TELEMETRY_SYNC_1;
+    l_frame[l_index++] = TELEMETRY_SYNC_2;
+    l_frame[l_index++] = TELEMETRY_PAYLOAD_SIZE;
+    Telemetry_put16(l_frame, &l_index, (uint16) l_time);
+    Telemetry_put16(l_frame, &l_index, (uint16) (l_time >> 16));
+    Telemetry_put16(l_frame, &l_index, a_sample->echoTicks);
+    Telemetry_put16(l_frame, &l_index, a_sample->distanceMm);
+    l_frame[l_index++] = a_sample->state;
+    Telemetry_put16(l_frame, &l_index, g_dropCount);
+    Telemetry_put16(l_frame, &l_index, l_power.sleepPermille);
+    Telemetry_put16(l_frame, &l_index, l_power.averageCurrentUa);
+    l_frame[l_index++] = Health_getFaultMask();
+    l_frame[l_index++] = g_healthSensor;
+    Telemetry_put16(l_frame, &l_index, l_health.timeouts);
+    Telemetry_put16(l_frame, &l_index, l_health.outOfRange);
+    Telemetry_put16(l_frame, &l_index, l_health.jumps);
+    if (++g_healthSensor >= ULTRASONIC_SENSOR_COUNT) {
+        g_healthSensor = 0;                       /**< One sensor per frame keeps the frame short */
+    }
+#ifdef PROBE_ENABLE
+    for (i = 0; i < PROBE_COUNT; i++) {
+        Probe_getStats(i, &l_probe);
+        l_mean = (l_probe.count == 0) ? 0 : (l_probe.total / l_probe.count);
+        Telemetry_put16(l_frame, &l_index, (l_probe.count > 0xFFFFUL) ? 0xFFFF : (uint16) l_probe.count);
+        Telemetry_put16(l_frame, &l_index, (l_probe.min > 0xFFFFUL) ? 0xFFFF : (uint16) l_probe.min);
+        Telemetry_put16(l_frame, &l_index, (l_probe.max > 0xFFFFUL) ? 0xFFFF : (uint16) l_probe.max);
+        Telemetry_put16(l_frame, &l_index, (l_mean > 0xFFFFUL) ? 0xFFFF : (uint16) l_mean);
+    }
+#endif
+
+    return Telemetry_queueFrame(l_frame, l_index);
+}
+
+/**
+ * @brief Queues a frame with the given payload without waiting, used for the command replies.
+ *
+ * @param a_payload The payload.
+ * @param a_length Length of the payload, up to TELEMETRY_COMMAND_MAX_PAYLOAD.
+ * @return FALSE if the frame was dropped because the UART buffer was full.
+ */
+boolean Telemetry_sendFrame(const uint8 *a_payload, uint8 a_length) {
+    uint8 l_frame[TELEMETRY_COMMAND_MAX_PAYLOAD + 4];
+    uint8 l_index = 0;
+    uint8 i;
+
+    if (a_length > TELEMETRY_COMMAND_MAX_PAYLOAD) {
+        return FALSE;
+    }
+
+    l_frame[l_index++] = TELEMETRY_SYNC_1;
+    l_frame[l_index++] = TELEMETRY_SYNC_2;
+    l_frame[l_index++] = a_length;
+    for (i = 0; i < a_length; i++) {
+        l_frame[l_index++] = a_payload[i];
+    }
+    return Telemetry_queueFrame(l_frame, l_index);
+}
+
+/**
+ * @brief Sets the function handling the received command frames.
+ *
+ * @param a_ptr Function called from Telemetry_poll() with the payload and its length.
+ */
+void Telemetry_setCommandCallBack(void (*a_ptr)(const uint8 *a_payload, uint8 a_length)) {
+    g_commandCallBack = a_ptr;
+}
+
+/**
+ * @brief Parses the bytes received since the last call and hands every valid command frame to the callback.
+ *
+ * A sync byte seen where the second one is expected may start a frame, so no frame is missed
+ * after a stray 0xA5.
+ */
+void Telemetry_poll(void) {
+    uint8 l_byte;
+
+    while (UART_readByte(&l_byte)) {
+        switch (g_rxStep) {
+        case TELEMETRY_RX_SYNC_1:
+            if (l_byte == TELEMETRY_SYNC_1) {
+                g_rxStep = TELEMETRY_RX_SYNC_2;
+            }
+            break;
+        case TELEMETRY_RX_SYNC_2:
+            if (l_byte == TELEMETRY_SYNC_2) {
+                g_rxStep = TELEMETRY_RX_LENGTH;
+            } else if (l_byte != TELEMETRY_SYNC_1) {
+                g_rxStep = TELEMETRY_RX_SYNC_1;
+            }
+            break;
+        case TELEMETRY_RX_LENGTH:
+            if ((l_byte == 0) || (l_byte > TELEMETRY_COMMAND_MAX_PAYLOAD)) {
+                g_rxStep = TELEMETRY_RX_SYNC_1;   /**< Not a command frame, look for the next one */
+            } else {
+                g_rxLength = l_byte;
+                g_rxIndex = 0;
+                g_rxSum = l_byte;
+                g_rxStep = TELEMETRY_RX_PAYLOAD;
+            }
+            break;
+        case TELEMETRY_RX_PAYLOAD:
+            g_rxPayload[g_rxIndex++] = l_byte;
+            g_rxSum += l_byte;
+            if (g_rxIndex == g_rxLength) {
+                g_rxStep = TELEMETRY_RX_CHECKSUM;
+            }
+            break;
+        default:
+            g_rxStep = TELEMETRY_RX_SYNC_1;
+            if ((l_byte == (uint8) ~g_rxSum) && (g_commandCallBack != NULL_PTR)) {
+                (*g_commandCallBack)(g_rxPayload, g_rxLength);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of frames dropped since Telemetry_init().
+ *
+ * @return The dropped frame count, saturated at 0xFFFF.
+ */
+uint16 Telemetry_getDropCount(void) {
+    return g_dropCount;
+}
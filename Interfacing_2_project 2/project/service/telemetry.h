@@ -0,0 +1,133 @@
+/**
+ * @file telemetry.h
+ * @brief Binary telemetry frames over the UART.
+ *
+ * This file provides the declarations for a compact binary frame carrying one sample of the
+ * application (timestamp, raw echo, filtered distance, state) together with the power, health
+ * and probe statistics. Frames are queued without waiting: a frame that does not fit in the UART buffer
+ * is dropped and counted, so logging never delays the sensing.
+ *
+ * Frame layout, multi-byte fields little endian:
+ * - 0xA5 0x5A sync bytes
+ * - payload length
+ * - payload: timestamp ms (4), echo ticks (2), filtered distance mm (2), state (1),
+ *   dropped frames (2), sleep permille (2), average current uA (2), fault mask (1), then the
+ *   fault statistics of one sensor, the next one in every frame: sensor (1), timeouts (2),
+ *   out-of-range captures (2), jumps (2), then with PROBE_ENABLE the count, min, max and mean
+ *   of every probe, durations in Timer0 clocks, all saturated at 0xFFFF (2 each), min 0xFFFF
+ *   for a probe that never ran
+ * - checksum: complement of the 8-bit sum of the length and payload bytes
+ *
+ * Commands are received in frames of the same layout, up to TELEMETRY_COMMAND_MAX_PAYLOAD bytes
+ * of payload whose first byte is the command. The application handles them and answers with a
+ * frame whose first payload byte is the command with TELEMETRY_REPLY_FLAG, always shorter
+ * than a sample frame.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include "../common/std_types.h"
+#include "probe.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Baud rate of the telemetry link, 57600 is within 1% at 16 MHz in double speed mode.
+ */
+#define TELEMETRY_BAUD_RATE 57600UL
+
+#define TELEMETRY_SYNC_1 0xA5 /**< @brief First sync byte of a frame. */
+#define TELEMETRY_SYNC_2 0x5A /**< @brief Second sync byte of a frame. */
+
+/**
+ * @brief Payload length of a frame.
+ */
+#ifdef PROBE_ENABLE
+#define TELEMETRY_PAYLOAD_SIZE (23 + 8 * PROBE_COUNT)
+#else
+#define TELEMETRY_PAYLOAD_SIZE 23
+#endif
+
+/**
+ * @brief Total length of a frame: sync, length, payload and checksum.
+ */
+#define TELEMETRY_FRAME_SIZE (TELEMETRY_PAYLOAD_SIZE + 4)
+
+/**
+ * @brief Largest payload of a command frame and of its reply.
+ */
+#define TELEMETRY_COMMAND_MAX_PAYLOAD 12
+
+/**
+ * @brief Flag set in the command byte of a reply.
+ */
+#define TELEMETRY_REPLY_FLAG 0x80
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Telemetry_SampleType
+ * @brief Application values carried by a frame.
+ */
+typedef struct {
+    uint16 echoTicks;  /**< Raw echo pulse of the nearest sensor in Timer1 ticks. */
+    uint16 distanceMm; /**< Filtered nearest distance. */
+    uint8 state;       /**< Current state of the application state machine. */
+} Telemetry_SampleType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/**
+ * @brief Initializes the UART for the telemetry link.
+ */
+void Telemetry_init(void);
+
+/**
+ * @brief Builds a frame from the sample and the statistics and queues it without waiting.
+ *
+ * @param a_sample Pointer to the application values.
+ * @return FALSE if the frame was dropped because the UART buffer was full.
+ */
+boolean Telemetry_send(const Telemetry_SampleType *a_sample);
+
+/**
+ * @brief Sets the function handling the received command frames.
+ *
+ * @param a_ptr Function called from Telemetry_poll() with the payload and its length (at least 1).
+ */
+void Telemetry_setCommandCallBack(void (*a_ptr)(const uint8 *a_payload, uint8 a_length));
+
+/**
+ * @brief Parses the bytes received since the last call and hands every valid command frame to the callback.
+ *
+ * A frame with a wrong checksum or length is skipped and the parser looks for the next sync bytes.
+ */
+void Telemetry_poll(void);
+
+/**
+ * @brief Queues a frame with the given payload without waiting, used for the command replies.
+ *
+ * @param a_payload The payload.
+ * @param a_length Length of the payload, up to TELEMETRY_COMMAND_MAX_PAYLOAD.
+ * @return FALSE if the frame was dropped because the UART buffer was full.
+ */
+boolean Telemetry_sendFrame(const uint8 *a_payload, uint8 a_length);
+
+/**
+ * @brief Returns the number of frames dropped since Telemetry_init().
+ *
+ * @return The dropped frame count, saturated at 0xFFFF.
+ */
+uint16 Telemetry_getDropCount(void);
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,24 @@
+/**
+ * @file interrupt.h
+ * @brief Host stand-in of <avr/interrupt.h> for the simulation build.
+ *
+ * The global interrupt flag is bit 7 of the simulated SREG. Interrupts pending when it is set are
+ * served at the next point where the simulated time moves (busy wait, timestamp poll or sleep),
+ * so sei() followed by sleep_cpu() wakes at once on a pending interrupt like the target does.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define sei() (SREG |= (uint8_t) (1 << SREG_I))
+#define cli() (SREG &= (uint8_t) ~(1 << SREG_I))
+
+/* An interrupt handler is a plain function called by the simulator */
+#define ISR(vector) void vector(void)
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
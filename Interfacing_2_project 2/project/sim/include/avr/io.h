@@ -0,0 +1,94 @@
+/**
+ * @file io.h
+ * @brief Host stand-in of <avr/io.h> for the simulation build.
+ *
+ * The I/O registers used by the drivers compiled unchanged (GPIO, UART and the SREG accesses
+ * of the HAL) live in the simulated I/O space g_simIo, at their ATmega32 data space addresses.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_AVR_IO_H_
+#define SIM_AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t g_simIo[0x60];
+
+#define _SFR_MEM8(address) (g_simIo[(address)])
+
+#define PINA _SFR_MEM8(0x39)
+#define DDRA _SFR_MEM8(0x3A)
+#define PORTA _SFR_MEM8(0x3B)
+#define PINB _SFR_MEM8(0x36)
+#define DDRB _SFR_MEM8(0x37)
+#define PORTB _SFR_MEM8(0x38)
+#define PINC _SFR_MEM8(0x33)
+#define DDRC _SFR_MEM8(0x34)
+#define PORTC _SFR_MEM8(0x35)
+#define PIND _SFR_MEM8(0x30)
+#define DDRD _SFR_MEM8(0x31)
+#define PORTD _SFR_MEM8(0x32)
+#define UBRRL _SFR_MEM8(0x29)
+#define UCSRB _SFR_MEM8(0x2A)
+#define UCSRA _SFR_MEM8(0x2B)
+#define UDR _SFR_MEM8(0x2C)
+#define UBRRH _SFR_MEM8(0x40)
+#define SREG _SFR_MEM8(0x5F)
+
+/* Port bits */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+/* SREG */
+#define SREG_I 7
+
+/* UCSRA */
+#define U2X 1
+#define UDRE 5
+
+/* UCSRB */
+#define TXEN 3
+#define RXEN 4
+#define UDRIE 5
+#define RXCIE 7
+
+/* UCSRC */
+#define UCSZ0 1
+#define UCSZ1 2
+#define USBS 3
+#define UPM0 4
+#define URSEL 7
+
+#endif /* SIM_AVR_IO_H_ */
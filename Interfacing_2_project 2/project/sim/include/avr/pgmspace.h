@@ -0,0 +1,25 @@
+/**
+ * @file pgmspace.h
+ * @brief Host stand-in of <avr/pgmspace.h> for the simulation build, flash data is plain memory.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_AVR_PGMSPACE_H_
+#define SIM_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#define pgm_read_word(address) (*(const uint16_t *) (address))
+/* Read through the pointed type, the uint32 of std_types.h is 64 bits wide on the host */
+#define pgm_read_dword(address) ((uint32_t) *(address))
+#define pgm_read_ptr(address) (*(void * const *) (address))
+#define memcpy_P(dst, src, n) memcpy((dst), (src), (n))
+#define strlen_P(s) strlen(s)
+
+#endif /* SIM_AVR_PGMSPACE_H_ */
@@ -0,0 +1,22 @@
+/**
+ * @file sleep.h
+ * @brief Host stand-in of <avr/sleep.h> for the simulation build.
+ *
+ * Sleeping advances the simulated time to the next interrupt and serves it.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+void Sim_sleep(void);
+
+#define SLEEP_MODE_IDLE 0
+#define set_sleep_mode(mode) ((void) (mode))
+#define sleep_enable() ((void) 0)
+#define sleep_disable() ((void) 0)
+#define sleep_cpu() Sim_sleep()
+
+#endif /* SIM_AVR_SLEEP_H_ */
@@ -0,0 +1,22 @@
+/**
+ * @file delay.h
+ * @brief Host stand-in of <util/delay.h> for the simulation build.
+ *
+ * A busy wait advances the simulated time by its length, interrupts due meanwhile are served
+ * if they are enabled.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+#include <stdint.h>
+
+void Sim_delayCycles(uint64_t a_cycles);
+
+#define _delay_us(us) Sim_delayCycles((uint64_t) ((us) * (F_CPU / 1000000.0)))
+#define _delay_ms(ms) Sim_delayCycles((uint64_t) ((ms) * (F_CPU / 1000.0)))
+
+#endif /* SIM_UTIL_DELAY_H_ */
@@ -0,0 +1,324 @@
+/**
+ * @file sim_bench.c
+ * @brief Alert latency benchmark of the host simulation build.
+ *
+ * A benchmark replaces the trace by episodes of a distance profile: the obstacle rests out of
+ * range for a random time, then crosses the danger distance either at once (step) or at a given
+ * speed (ramp), holds close and leaves. The alert latency of an episode runs from the crossing to
+ * the first rising edge of the buzzer pin after the application asked for the danger pattern.
+ * The danger distance is the one the application uses, read at every crossing, so thresholds
+ * stored in the EEPROM or set over the link are benchmarked as they are. A run fails when an
+ * alert is missed or spurious, or when the worst latency exceeds the budget.
+ * The LCD bus is decoded from its pins to report the share of time it is busy.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+
+#include "../hal/ultrasonic.h"
+#include "../hal/buzzer.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_BENCH_NO_TIME UINT64_MAX
+#define SIM_BENCH_CYCLES_PER_MS (F_CPU / 1000UL)
+#define SIM_BENCH_CYCLES_PER_US (F_CPU / 1000000UL)
+
+/** @brief Distance of the obstacle out of range and close, in mm. */
+#define SIM_BENCH_FAR_MM 400
+#define SIM_BENCH_NEAR_MM 30
+
+/** @brief Rest out of range before each crossing, plus a random part so the crossings hit every ping phase. */
+#ifndef SIM_BENCH_REST_MS
+#define SIM_BENCH_REST_MS 2000UL
+#endif
+#define SIM_BENCH_REST_JITTER_MS 1000UL
+
+/** @brief Time the obstacle holds close after reaching SIM_BENCH_NEAR_MM. */
+#define SIM_BENCH_HOLD_MS 2000UL
+
+/** @brief Default approach speed of the ramp profile in mm/s. */
+#define SIM_BENCH_RAMP_MM_S 250UL
+
+/** @brief Buzzer pin (PC5) and LCD pins (RS PA1, E PA2, D4-D7 PA3-PA6) as wired in buzzer.h and lcd.h. */
+#define SIM_BENCH_BUZZER_BIT 5
+#define SIM_BENCH_LCD_RS_BIT 1
+#define SIM_BENCH_LCD_E_BIT 2
+#define SIM_BENCH_LCD_D4_BIT 3
+
+/** @brief HD44780 execution times in us: clear and home, other commands, data writes. */
+#define SIM_BENCH_LCD_HOME_US 1520UL
+#define SIM_BENCH_LCD_COMMAND_US 37UL
+#define SIM_BENCH_LCD_DATA_US 41UL
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct SimBench_EpisodeType
+ * @brief One approach of the obstacle.
+ */
+typedef struct {
+    uint64_t approachAt; /**< Cycle the obstacle leaves SIM_BENCH_FAR_MM. */
+    uint64_t nearAt;     /**< Cycle it reaches SIM_BENCH_NEAR_MM. */
+    uint64_t leaveAt;    /**< Cycle it jumps back to SIM_BENCH_FAR_MM. */
+    uint64_t alertAt;    /**< Cycle of the alert, SIM_BENCH_NO_TIME if it never came. */
+} SimBench_EpisodeType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static SimBench_EpisodeType *g_episodes = NULL;
+static uint32 g_episodeCount = 0;
+static uint32 g_episode = 0;           /**< Episode of the current cycle. */
+static const char *g_profileName = NULL;
+static uint32 g_rampSpeed = 0;         /**< mm/s, 0 for the step profile. */
+static uint32 g_seed = 1;
+static uint64_t g_budget = 0;          /**< Largest alert latency in cycles that passes. */
+
+static boolean g_alertRequested = FALSE;
+static uint32 g_spuriousAlerts = 0;  /**< Alerts before any crossing or repeated for one crossing. */
+static uint8 g_buzzerLevel = 0;
+
+static uint8 g_lcdE = 0;
+static uint8 g_lcdNibbles = 0;
+static uint8 g_lcdByte = 0;
+static uint64_t g_lcdByteStart = SIM_BENCH_NO_TIME;
+static uint64_t g_lcdBusyUntil = 0;
+static uint64_t g_lcdBusyCycles = 0;
+static uint32 g_lcdBytes = 0;
+
+/* Danger threshold in use by the application */
+uint16 APP_getDangerMm(void);
+
+/*******************************************************************************
+ *                              Profiles                                       *
+ *******************************************************************************/
+
+/* Pseudo random numbers of the rest times, the same for every configuration with the same seed */
+static uint32 SimBench_random(void) {
+    g_seed = g_seed * 1103515245UL + 12345UL;
+    return (g_seed >> 16) & 0x7FFF;
+}
+
+/**
+ * @brief Sets up a benchmark, returns the cycle at which it ends or 0 for an unknown profile.
+ *
+ * @param a_spec "step" or "ramp[:mm/s]".
+ * @param a_episodes Number of crossings.
+ * @param a_seed Seed of the rest times.
+ * @param a_budgetMs Largest alert latency that passes in ms.
+ */
+uint64_t SimBench_setup(const char *a_spec, uint32_t a_episodes, uint32_t a_seed, uint32_t a_budgetMs) {
+    uint64_t l_time = 0;
+    uint32 i;
+
+    if (strcmp(a_spec, "step") == 0) {
+        g_rampSpeed = 0;
+    } else if (strncmp(a_spec, "ramp", 4) == 0) {
+        g_rampSpeed = (a_spec[4] == ':') ? strtoul(a_spec + 5, NULL, 10) : SIM_BENCH_RAMP_MM_S;
+        if (g_rampSpeed == 0) {
+            return 0;
+        }
+    } else {
+        return 0;
+    }
+    g_profileName = a_spec;
+    g_seed = a_seed;
+    g_budget = (uint64_t) a_budgetMs * SIM_BENCH_CYCLES_PER_MS;
+    g_episodeCount = a_episodes;
+    g_episodes = calloc(a_episodes, sizeof(SimBench_EpisodeType));
+
+    for (i = 0; i < g_episodeCount; i++) {
+        l_time += (SIM_BENCH_REST_MS + SimBench_random() % SIM_BENCH_REST_JITTER_MS) * SIM_BENCH_CYCLES_PER_MS
+                + SimBench_random() % SIM_BENCH_CYCLES_PER_MS;
+        g_episodes[i].approachAt = l_time;
+        if (g_rampSpeed == 0) {
+            g_episodes[i].nearAt = l_time;
+        } else {
+            g_episodes[i].nearAt = l_time + (uint64_t) (SIM_BENCH_FAR_MM - SIM_BENCH_NEAR_MM) * F_CPU / g_rampSpeed;
+        }
+        g_episodes[i].leaveAt = g_episodes[i].nearAt + SIM_BENCH_HOLD_MS * SIM_BENCH_CYCLES_PER_MS;
+        g_episodes[i].alertAt = SIM_BENCH_NO_TIME;
+        l_time = g_episodes[i].leaveAt;
+    }
+    return l_time + SIM_BENCH_REST_MS * SIM_BENCH_CYCLES_PER_MS;
+}
+
+/* Cycle an episode crosses the danger distance of the application, at the latest when it gets near */
+static uint64_t SimBench_crossAt(const SimBench_EpisodeType *a_episode) {
+    uint16 l_danger = APP_getDangerMm();
+
+    if ((g_rampSpeed == 0) || (l_danger >= SIM_BENCH_FAR_MM)) {
+        return a_episode->approachAt;
+    }
+    if (l_danger <= SIM_BENCH_NEAR_MM) {
+        return a_episode->nearAt;
+    }
+    return a_episode->approachAt + (uint64_t) (SIM_BENCH_FAR_MM - l_danger) * F_CPU / g_rampSpeed;
+}
+
+/* Moves to the episode of a cycle, the rest before an episode belongs to it */
+static SimBench_EpisodeType *SimBench_episodeAt(uint64_t a_now) {
+    while ((g_episode + 1 < g_episodeCount) && (a_now >= g_episodes[g_episode].leaveAt)) {
+        g_episode++;
+    }
+    return &g_episodes[g_episode];
+}
+
+/**
+ * @brief Returns the echo width in ULTRASONIC_ICU_CLOCK ticks of a ping at a cycle.
+ *
+ * The distance is taken at the ping, it does not move during the few milliseconds of the echo.
+ */
+uint16_t SimBench_echoTicks(uint64_t a_now, uint32_t a_icuPrescaler) {
+    const SimBench_EpisodeType *l_episode = SimBench_episodeAt(a_now);
+    uint64_t l_distance = SIM_BENCH_FAR_MM;
+
+    if ((a_now >= l_episode->nearAt) && (a_now < l_episode->leaveAt)) {
+        l_distance = SIM_BENCH_NEAR_MM;
+    } else if ((a_now >= l_episode->approachAt) && (a_now < l_episode->nearAt)) {
+        l_distance = SIM_BENCH_FAR_MM - (a_now - l_episode->approachAt) * g_rampSpeed / F_CPU;
+    }
+
+    /* ticks = distance * 2 * F_CPU / (prescaler * speed of sound) */
+    return (uint16_t) ((l_distance * 2ULL * F_CPU + (a_icuPrescaler * ULTRASONIC_SPEED_OF_SOUND_MM_S) / 2)
+            / (a_icuPrescaler * ULTRASONIC_SPEED_OF_SOUND_MM_S));
+}
+
+/*******************************************************************************
+ *                               Monitors                                      *
+ *******************************************************************************/
+
+/**
+ * @brief Wrapper of Buzzer_playPattern() called by the application, notes the danger pattern requests.
+ */
+void Sim_playPattern(Buzzer_PatternType a_pattern) {
+    if (a_pattern == BUZZER_PATTERN_DANGER) {
+        g_alertRequested = TRUE;
+    }
+    Buzzer_playPattern(a_pattern);
+}
+
+/* Decodes the LCD bus: two nibbles latched on the falling edges of E make a byte */
+static void SimBench_watchLcd(uint64_t a_now) {
+    uint8 l_e = (PORTA >> SIM_BENCH_LCD_E_BIT) & 1;
+    uint64_t l_end;
+
+    if (l_e && !g_lcdE && (g_lcdNibbles == 0)) {
+        g_lcdByteStart = a_now;
+    } else if (!l_e && g_lcdE) {
+        g_lcdByte = (uint8) ((g_lcdByte << 4) | ((PORTA >> SIM_BENCH_LCD_D4_BIT) & 0x0F));
+        if (++g_lcdNibbles == 2) {
+            if (PORTA & (1 << SIM_BENCH_LCD_RS_BIT)) {
+                l_end = a_now + SIM_BENCH_LCD_DATA_US * SIM_BENCH_CYCLES_PER_US;
+            } else if (g_lcdByte <= 0x03) {
+                l_end = a_now + SIM_BENCH_LCD_HOME_US * SIM_BENCH_CYCLES_PER_US;
+            } else {
+                l_end = a_now + SIM_BENCH_LCD_COMMAND_US * SIM_BENCH_CYCLES_PER_US;
+            }
+            g_lcdBusyCycles += l_end - ((g_lcdByteStart > g_lcdBusyUntil) ? g_lcdByteStart : g_lcdBusyUntil);
+            g_lcdBusyUntil = l_end;
+            g_lcdNibbles = 0;
+            g_lcdBytes++;
+        }
+    }
+    g_lcdE = l_e;
+}
+
+/**
+ * @brief Observes the buzzer and LCD pins at a simulation point.
+ */
+void SimBench_watch(uint64_t a_now) {
+    uint8 l_buzzer = (PORTC >> SIM_BENCH_BUZZER_BIT) & 1;
+    SimBench_EpisodeType *l_episode;
+
+    SimBench_watchLcd(a_now);
+
+    if (l_buzzer && !g_buzzerLevel && g_alertRequested) {
+        g_alertRequested = FALSE;
+        if (g_episodeCount != 0) {
+            /* The alert belongs to the last crossing, even when the obstacle already left again */
+            l_episode = SimBench_episodeAt(a_now);
+            if ((a_now < SimBench_crossAt(l_episode)) && (l_episode != g_episodes)) {
+                l_episode--;
+            }
+            if ((a_now >= SimBench_crossAt(l_episode)) && (l_episode->alertAt == SIM_BENCH_NO_TIME)) {
+                l_episode->alertAt = a_now;
+            } else {
+                g_spuriousAlerts++;
+            }
+        }
+    }
+    g_buzzerLevel = l_buzzer;
+}
+
+/*******************************************************************************
+ *                                Report                                       *
+ *******************************************************************************/
+
+static int SimBench_compare(const void *a_left, const void *a_right) {
+    uint64_t l_left = *(const uint64_t *) a_left;
+    uint64_t l_right = *(const uint64_t *) a_right;
+
+    return (l_left > l_right) - (l_left < l_right);
+}
+
+/* Nearest rank percentile of sorted latencies */
+static double SimBench_percentile(const uint64_t *a_sorted, uint32 a_count, uint32 a_percent) {
+    uint32 l_rank = (a_count * a_percent + 99) / 100;
+
+    return (double) a_sorted[(l_rank == 0) ? 0 : l_rank - 1] / SIM_BENCH_CYCLES_PER_MS;
+}
+
+/**
+ * @brief Prints the LCD bus occupancy, then the alert latency and the ping rate of a benchmark.
+ *
+ * @param a_now The current cycle.
+ * @param a_pinged Number of pings sent.
+ * @return 0 if the benchmark missed its budget: an alert missed or spurious, or too late.
+ */
+int SimBench_report(uint64_t a_now, uint32_t a_pinged) {
+    uint64_t *l_latencies;
+    uint32 l_count = 0;
+    uint32 i;
+    int l_met;
+
+    printf("LCD bus          : %lu bytes, busy %.2f %% of the time\n", (unsigned long) g_lcdBytes,
+            (a_now == 0) ? 0.0 : 100.0 * (double) g_lcdBusyCycles / (double) a_now);
+    if (g_episodeCount == 0) {
+        return 1;
+    }
+
+    l_latencies = malloc(g_episodeCount * sizeof(uint64_t));
+    for (i = 0; i < g_episodeCount; i++) {
+        if (g_episodes[i].alertAt != SIM_BENCH_NO_TIME) {
+            l_latencies[l_count++] = g_episodes[i].alertAt - SimBench_crossAt(&g_episodes[i]);
+        }
+    }
+    qsort(l_latencies, l_count, sizeof(uint64_t), SimBench_compare);
+
+    printf("Ping rate        : %.2f Hz\n", (double) a_pinged * 1000.0 * SIM_BENCH_CYCLES_PER_MS / (double) a_now);
+    if (l_count != 0) {
+        printf("Alert latency    : %s, %lu crossings, p50 %.1f ms, p99 %.1f ms, max %.1f ms, %lu missed, %lu spurious\n",
+                g_profileName, (unsigned long) g_episodeCount, SimBench_percentile(l_latencies, l_count, 50),
+                SimBench_percentile(l_latencies, l_count, 99), SimBench_percentile(l_latencies, l_count, 100),
+                (unsigned long) (g_episodeCount - l_count), (unsigned long) g_spuriousAlerts);
+    } else {
+        printf("Alert latency    : %s, %lu crossings, no alert\n", g_profileName, (unsigned long) g_episodeCount);
+    }
+    l_met = (l_count == g_episodeCount) && (g_spuriousAlerts == 0)
+            && ((l_count == 0) || (l_latencies[l_count - 1] <= g_budget));
+    printf("Alert budget     : %.0f ms, %s\n", (double) g_budget / SIM_BENCH_CYCLES_PER_MS, l_met ? "met" : "MISSED");
+    free(l_latencies);
+    return l_met;
+}
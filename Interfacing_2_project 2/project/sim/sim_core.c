@@ -0,0 +1,614 @@
+/**
+ * @file sim_core.c
+ * @brief Simulated clock, interrupt controller, sensor and UART models of the host simulation build.
+ *
+ * The clock counts CPU cycles and only moves at the simulation points: busy waits, timestamp
+ * polls and sleep. At every point the pending interrupts are served in vector priority order
+ * while the global interrupt flag is set, and the falling edge of the trigger pin starts the echo
+ * of the next sample, read from the trace or from the distance profile of a benchmark (sim_bench.c).
+ * A trace run ends SIM_TAIL_MS after its last sample, a benchmark after its last episode, with a
+ * report of the startup milestones, the echo-to-reading latency, the time per state, the sensor
+ * health and the sleep share.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+
+#include "../mcal/icu.h"
+#include "../hal/ultrasonic.h"
+#include "../service/power.h"
+#include "../service/telemetry.h"
+#include "../service/probe.h"
+#include "../service/health.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/** @brief Value of an event time when the event is not scheduled. */
+#define SIM_NO_EVENT UINT64_MAX
+
+/** @brief CPU cycles per millisecond. */
+#define SIM_CYCLES_PER_MS (F_CPU / 1000UL)
+
+/** @brief Delay from the end of the trigger pulse to the echo rising edge (HC-SR04 burst). */
+#define SIM_ECHO_DELAY_CYCLES (450UL * (F_CPU / 1000000UL))
+
+/** @brief Cycles per echo tick of the traces, an ULTRASONIC_ICU_CLOCK tick whatever range timed the echo. */
+#define SIM_ECHO_TICK_CYCLES ICU_PRESCALER_VALUE(ULTRASONIC_ICU_CLOCK)
+
+/** @brief Width of the echo the HC-SR04 sends when nothing is in range (38 ms). */
+#define SIM_NO_ECHO_CYCLES (38UL * SIM_CYCLES_PER_MS)
+
+/** @brief Sample ticks of a sensor that does not answer at all, "lost" in a trace. */
+#define SIM_TICKS_LOST 0xFFFF
+
+/** @brief Simulated time after the last sample of the trace before the report. */
+#define SIM_TAIL_MS 1000UL
+
+/** @brief Trigger pin sampled at every simulation point (PD7). */
+#define SIM_TRIGGER_PORT PORTD
+#define SIM_TRIGGER_BIT 7
+
+/** @brief Echo pin driven by the sensor model (ICP1, PD6). */
+#define SIM_ECHO_PIN PIND
+#define SIM_ECHO_BIT 6
+
+/** @brief Number of states of the application state machine, in the order of STATE_MACHINE. */
+#define SIM_STATE_COUNT 6
+
+/** @brief Number of startup milestones of the application, in the order of APP_StartupEventType. */
+#define SIM_STARTUP_EVENTS 3
+
+/** @brief Exit status of a run that missed a startup or alert latency budget. */
+#define SIM_EXIT_OVER_BUDGET 2
+
+/** @brief Default budget of the worst alert latency of a benchmark in ms, the blocking delays of the original loop. */
+#define SIM_ALERT_BUDGET_MS 400UL
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @struct Sim_SampleType
+ * @brief One sample of the trace and what became of it.
+ */
+typedef struct {
+    uint16 ticks;       /**< Echo width in ULTRASONIC_ICU_CLOCK ticks, 0 for no echo, SIM_TICKS_LOST for none at all. */
+    uint64_t pingAt;    /**< Cycle of the trigger that measured it. */
+    uint64_t doneAt;    /**< Cycle of the echo falling edge, or of the driver timeout without echo. */
+    boolean collected;  /**< TRUE once the application read the measurement. */
+} Sim_SampleType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/** @brief Simulated I/O space at the ATmega32 data space addresses, word aligned for the register unions. */
+volatile uint8_t g_simIo[0x60] __attribute__((aligned(2)));
+
+/* State of the application observed for the timeline */
+extern uint8 g_stateMachine;
+extern uint16 g_distance;
+extern uint32 g_startupTimes[SIM_STARTUP_EVENTS];
+extern const uint16 g_startupBudgets[SIM_STARTUP_EVENTS];
+
+int App_main(void);
+void USART_UDRE_vect(void);
+
+static uint64_t g_now = 0;
+static boolean g_pending[SIM_IRQ_COUNT];
+static uint32 g_servedCount = 0;
+static uint64_t g_endAt = SIM_NO_EVENT;
+static boolean g_quiet = FALSE;
+static boolean g_bench = FALSE;
+static boolean g_checkStartup = FALSE;
+
+static const char *const g_stateNames[SIM_STATE_COUNT] = { "IDLE", "DETECTED", "SAFE", "WARNING", "DANGER", "FAULT" };
+static const char *const g_startupNames[SIM_STARTUP_EVENTS] = { "first sample", "first LCD frame", "first alert" };
+static uint8 g_lastState = 0xFF;
+static uint64_t g_stateSince = 0;
+static uint64_t g_stateCycles[SIM_STATE_COUNT];
+
+/* Sensor model */
+static Sim_SampleType *g_samples = NULL;
+static uint32 g_sampleCount = 0;
+static uint32 g_pinged = 0;
+static uint8 g_triggerLevel = 0;
+static uint64_t g_echoRiseAt = SIM_NO_EVENT;
+static uint64_t g_echoFallAt = SIM_NO_EVENT;
+
+/* Latency statistics */
+static uint32 g_collected = 0;
+static uint32 g_collectedNoEcho = 0;
+static uint64_t g_latencyMin = SIM_NO_EVENT;
+static uint64_t g_latencyMax = 0;
+static uint64_t g_latencyTotal = 0;
+static uint32 g_latencyCount = 0;
+
+/* UART model */
+static uint64_t g_uartBusyUntil = 0;
+static uint32 g_uartBytes = 0;
+static FILE *g_uartOut = NULL;
+
+/*******************************************************************************
+ *                              Report                                         *
+ *******************************************************************************/
+
+static double Sim_ms(uint64_t a_cycles) {
+    return (double) a_cycles / SIM_CYCLES_PER_MS;
+}
+
+/* Prints the startup milestones, returns FALSE if one is checked and missed its budget */
+static boolean Sim_reportStartup(void) {
+    boolean l_met = TRUE;
+    uint8 i;
+
+    printf("Startup          :");
+    for (i = 0; i < SIM_STARTUP_EVENTS; i++) {
+        if (g_startupTimes[i] == 0) {
+            printf("%s %s -", (i == 0) ? "" : ",", g_startupNames[i]);
+        } else {
+            printf("%s %s %lu ms", (i == 0) ? "" : ",", g_startupNames[i], (unsigned long) g_startupTimes[i]);
+        }
+    }
+    printf("\n");
+    if (g_checkStartup) {
+        for (i = 0; i < SIM_STARTUP_EVENTS; i++) {
+            if ((g_startupTimes[i] == 0) || (g_startupTimes[i] > g_startupBudgets[i])) {
+                printf("Startup budget   : %s missed its %u ms budget\n", g_startupNames[i], g_startupBudgets[i]);
+                l_met = FALSE;
+            }
+        }
+        if (l_met) {
+            printf("Startup budget   : met\n");
+        }
+    }
+    return l_met;
+}
+
+/* Prints the report, returns the exit status of the run */
+static int Sim_report(void) {
+    Power_StatsType l_power;
+    Health_SensorStatsType l_health;
+#ifdef PROBE_ENABLE
+    Probe_StatsType l_probe;
+#endif
+    uint32 l_lost = 0;
+    uint32 i;
+    int l_status;
+
+    if (g_lastState < SIM_STATE_COUNT) {
+        g_stateCycles[g_lastState] += g_now - g_stateSince;
+    }
+    for (i = 0; i < g_pinged; i++) {
+        if (!g_samples[i].collected && (g_samples[i].doneAt <= g_now)) {
+            l_lost++;
+        }
+    }
+    Power_getStats(&l_power);
+
+    printf("\nSimulated time   : %.1f ms\n", Sim_ms(g_now));
+    l_status = Sim_reportStartup() ? 0 : SIM_EXIT_OVER_BUDGET;
+    printf("Samples          : %lu of %lu pinged, %lu collected (%lu without echo), %lu not collected, %u dropped by the full ring\n",
+            (unsigned long) g_pinged, (unsigned long) g_sampleCount, (unsigned long) g_collected,
+            (unsigned long) g_collectedNoEcho, (unsigned long) l_lost, Ultrasonic_getSampleOverflows());
+    if (g_latencyCount != 0) {
+        printf("Echo to reading  : min %.3f ms, mean %.3f ms, max %.3f ms\n", Sim_ms(g_latencyMin),
+                Sim_ms(g_latencyTotal / g_latencyCount), Sim_ms(g_latencyMax));
+    }
+    printf("Time in state    :");
+    for (i = 0; i < SIM_STATE_COUNT; i++) {
+        printf(" %s %.0f ms", g_stateNames[i], Sim_ms(g_stateCycles[i]));
+    }
+    for (i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+        Health_getSensorStats((uint8) i, &l_health);
+        printf("\nHealth sensor %lu  : %u timeouts, %u out of range, %u jumps%s", (unsigned long) i,
+                l_health.timeouts, l_health.outOfRange, l_health.jumps, l_health.faulty ? ", faulty" : "");
+    }
+    printf("\nIdle sleep       : %lu of %lu ms (%u.%u %%), average MCU current %u uA\n",
+            (unsigned long) l_power.sleepMs, (unsigned long) l_power.elapsedMs, l_power.sleepPermille / 10, l_power.sleepPermille % 10, l_power.averageCurrentUa);
+    printf("Telemetry        : %lu bytes sent, %u frames dropped\n", (unsigned long) g_uartBytes,
+            Telemetry_getDropCount());
+    if (!SimBench_report(g_now, g_pinged)) {
+        l_status = SIM_EXIT_OVER_BUDGET;
+    }
+#ifdef PROBE_ENABLE
+    /* The on-target measurement, from the first reading within the danger distance */
+    if (Probe_getStats(PROBE_ALERT_LATENCY, &l_probe) && (l_probe.count != 0)) {
+        printf("Alert probe      : %lu alerts, mean %.1f ms, max %.1f ms after the first danger reading\n",
+                (unsigned long) l_probe.count, Sim_ms((uint64_t) l_probe.total / l_probe.count * PROBE_CYCLES_PER_CLOCK),
+                Sim_ms((uint64_t) l_probe.max * PROBE_CYCLES_PER_CLOCK));
+    }
+#endif
+    return l_status;
+}
+
+/*******************************************************************************
+ *                         Simulation points                                   *
+ *******************************************************************************/
+
+/* Appends a sample of the given echo width */
+static void Sim_addSample(uint16 a_ticks) {
+    static uint32 s_capacity = 0;
+
+    if (g_sampleCount == s_capacity) {
+        s_capacity = (s_capacity == 0) ? 256 : s_capacity * 2;
+        g_samples = realloc(g_samples, s_capacity * sizeof(Sim_SampleType));
+    }
+    memset(&g_samples[g_sampleCount], 0, sizeof(Sim_SampleType));
+    g_samples[g_sampleCount].ticks = a_ticks;
+    g_sampleCount++;
+}
+
+/* Observes the pins and the application at the current cycle */
+static void Sim_watch(void) {
+    uint8 l_level = (SIM_TRIGGER_PORT >> SIM_TRIGGER_BIT) & 1;
+    Sim_SampleType *l_sample;
+    int l_status;
+
+    /* The HC-SR04 starts its burst on the falling edge of the trigger pulse */
+    if (g_triggerLevel && !l_level) {
+        if (g_bench) {
+            Sim_addSample(SimBench_echoTicks(g_now, SIM_ECHO_TICK_CYCLES));
+        }
+        if (g_pinged < g_sampleCount) {
+            l_sample = &g_samples[g_pinged++];
+            l_sample->pingAt = g_now;
+            if (l_sample->ticks == SIM_TICKS_LOST) {
+                /* No answer, the driver gives up on the first Timer1 overflow after the timeout, not before */
+                l_sample->doneAt = g_now + (uint64_t) ULTRASONIC_TIMEOUT_TICKS * SIM_ECHO_TICK_CYCLES;
+            } else if (l_sample->ticks != 0) {
+                g_echoRiseAt = g_now + SIM_ECHO_DELAY_CYCLES;
+                g_echoFallAt = g_echoRiseAt + (uint64_t) l_sample->ticks * SIM_ECHO_TICK_CYCLES;
+                l_sample->doneAt = g_echoFallAt;
+            } else {
+                /* Nothing in range, the driver gives up on the wide echo once the timeout elapsed, not before */
+                g_echoRiseAt = g_now + SIM_ECHO_DELAY_CYCLES;
+                g_echoFallAt = g_echoRiseAt + SIM_NO_ECHO_CYCLES;
+                l_sample->doneAt = g_echoRiseAt + (uint64_t) ULTRASONIC_TIMEOUT_TICKS * SIM_ECHO_TICK_CYCLES;
+            }
+            if ((g_pinged == g_sampleCount) && (g_endAt == SIM_NO_EVENT)) {
+                g_endAt = l_sample->doneAt + SIM_TAIL_MS * SIM_CYCLES_PER_MS;
+            }
+        } else {
+            /* Past the end of the trace the sensor keeps answering, with nothing in range */
+            g_echoRiseAt = g_now + SIM_ECHO_DELAY_CYCLES;
+            g_echoFallAt = g_echoRiseAt + SIM_NO_ECHO_CYCLES;
+        }
+    }
+    g_triggerLevel = l_level;
+    SimBench_watch(g_now);
+
+    if (g_stateMachine != g_lastState) {
+        if (g_lastState < SIM_STATE_COUNT) {
+            g_stateCycles[g_lastState] += g_now - g_stateSince;
+        }
+        g_lastState = g_stateMachine;
+        g_stateSince = g_now;
+        if (!g_quiet) {
+            if (g_distance == ULTRASONIC_NO_ECHO_DISTANCE) {
+                printf("%10.1f ms  sample %5lu  distance     -  %s\n", Sim_ms(g_now), (unsigned long) g_pinged,
+                        (g_lastState < SIM_STATE_COUNT) ? g_stateNames[g_lastState] : "?");
+            } else {
+                printf("%10.1f ms  sample %5lu  distance %5u  %s\n", Sim_ms(g_now), (unsigned long) g_pinged, g_distance,
+                        (g_lastState < SIM_STATE_COUNT) ? g_stateNames[g_lastState] : "?");
+            }
+        }
+    }
+
+    if (g_now >= g_endAt) {
+        l_status = Sim_report();
+        if (g_uartOut != NULL) {
+            fclose(g_uartOut);
+        }
+        exit(l_status);
+    }
+}
+
+/* Serves the pending interrupts while they are enabled, like RETI the handler returns with I set */
+static void Sim_serve(void) {
+    uint8 i;
+
+    while (SREG & (1 << SREG_I)) {
+        for (i = 0; (i < SIM_IRQ_COUNT) && !g_pending[i]; i++) {
+        }
+        if (i == SIM_IRQ_COUNT) {
+            break;
+        }
+        g_pending[i] = FALSE;
+        g_servedCount++;
+        SREG &= (uint8_t) ~(1 << SREG_I);
+
+        if (i == SIM_IRQ_USART_UDRE) {
+            if (UCSRB & (1 << UDRIE)) {
+                USART_UDRE_vect();
+
+                /* The handler only keeps the interrupt enabled when it loaded UDR */
+                if (UCSRB & (1 << UDRIE)) {
+                    uint16 l_ubrr = (uint16) (((UBRRH & 0x0F) << 8) | UBRRL);
+                    uint32 l_bitCycles = ((UCSRA & (1 << U2X)) ? 8UL : 16UL) * (l_ubrr + 1);
+
+                    g_uartBusyUntil = g_now + 10UL * l_bitCycles;
+                    g_uartBytes++;
+                    if (g_uartOut != NULL) {
+                        fputc(UDR, g_uartOut);
+                    }
+                }
+            }
+        } else {
+            SimMcal_serve((Sim_IrqType) i);
+        }
+
+        SREG |= (uint8_t) (1 << SREG_I);
+        Sim_watch();
+    }
+}
+
+/* Cycle of the next event of every model */
+static uint64_t Sim_nextEvent(void) {
+    uint64_t l_next = SimMcal_nextEvent();
+
+    if (g_echoRiseAt < l_next) {
+        l_next = g_echoRiseAt;
+    }
+    if (g_echoFallAt < l_next) {
+        l_next = g_echoFallAt;
+    }
+    /* UDRE is a level: one event when the transmitter frees up with the interrupt enabled */
+    if ((UCSRB & (1 << TXEN)) && (UCSRB & (1 << UDRIE)) && !g_pending[SIM_IRQ_USART_UDRE]) {
+        uint64_t l_free = (g_uartBusyUntil > g_now) ? g_uartBusyUntil : g_now;
+
+        if (l_free < l_next) {
+            l_next = l_free;
+        }
+    }
+    return l_next;
+}
+
+/* Runs the events due at the current cycle */
+static void Sim_process(void) {
+    SimMcal_process(g_now);
+
+    if (g_echoRiseAt <= g_now) {
+        g_echoRiseAt = SIM_NO_EVENT;
+        SIM_ECHO_PIN |= (uint8_t) (1 << SIM_ECHO_BIT);
+        SimMcal_echoEdge(TRUE);
+    }
+    if (g_echoFallAt <= g_now) {
+        g_echoFallAt = SIM_NO_EVENT;
+        SIM_ECHO_PIN &= (uint8_t) ~(1 << SIM_ECHO_BIT);
+        SimMcal_echoEdge(FALSE);
+    }
+    if ((UCSRB & (1 << TXEN)) && (UCSRB & (1 << UDRIE)) && (g_uartBusyUntil <= g_now)) {
+        g_pending[SIM_IRQ_USART_UDRE] = TRUE;
+    }
+}
+
+/* Advances the clock to a cycle, running the events and the interrupts met on the way */
+static void Sim_runUntil(uint64_t a_target) {
+    uint64_t l_next;
+
+    for (;;) {
+        Sim_watch();
+        Sim_serve();
+        l_next = Sim_nextEvent();
+        if (l_next > a_target) {
+            break;
+        }
+        if (l_next > g_now) {
+            g_now = l_next;
+        }
+        Sim_process();
+    }
+
+    /* A handler run on the way may already have moved the clock past the target */
+    if (a_target > g_now) {
+        g_now = a_target;
+    }
+    Sim_watch();
+    Sim_serve();
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint64_t Sim_now(void) {
+    return g_now;
+}
+
+void Sim_raise(Sim_IrqType a_irq) {
+    g_pending[a_irq] = TRUE;
+}
+
+void Sim_delayCycles(uint64_t a_cycles) {
+    Sim_runUntil(g_now + a_cycles);
+}
+
+/**
+ * @brief Sleeps until an interrupt is served, at once if one is already pending.
+ */
+void Sim_sleep(void) {
+    uint32 l_served = g_servedCount;
+    uint64_t l_next;
+
+    Sim_watch();
+    Sim_serve();
+    while (g_servedCount == l_served) {
+        l_next = Sim_nextEvent();
+        if (l_next == SIM_NO_EVENT) {
+            fprintf(stderr, "sim: sleeping with no interrupt source left at %.1f ms\n", Sim_ms(g_now));
+            Sim_report();
+            exit(1);
+        }
+        Sim_runUntil(l_next);
+    }
+}
+
+/**
+ * @brief Wrapper of Ultrasonic_readSamples() called by the application, measures the reading latency.
+ *
+ * The measurements complete and enter the sample ring in ping order, so every sample read is the
+ * oldest completed measurement not collected yet. Its latency runs from the echo falling edge
+ * (or the driver timeout without echo) to the read.
+ */
+uint8 Sim_readSamples(Ultrasonic_SampleType *a_samples, uint8 a_maxSamples) {
+    static uint32 s_next = 0;
+    uint8 l_count = Ultrasonic_readSamples(a_samples, a_maxSamples);
+    uint8 i;
+    uint64_t l_latency;
+
+    for (i = 0; i < l_count; i++) {
+        while ((s_next < g_pinged) && g_samples[s_next].collected) {
+            s_next++;
+        }
+        if ((s_next >= g_pinged) || (g_samples[s_next].doneAt > g_now)) {
+            break;
+        }
+        g_samples[s_next].collected = TRUE;
+        g_collected++;
+        if ((g_samples[s_next].ticks == 0) || (g_samples[s_next].ticks == SIM_TICKS_LOST)) {
+            g_collectedNoEcho++;
+        } else {
+            l_latency = g_now - g_samples[s_next].doneAt;
+            g_latencyTotal += l_latency;
+            g_latencyCount++;
+            if (l_latency < g_latencyMin) {
+                g_latencyMin = l_latency;
+            }
+            if (l_latency > g_latencyMax) {
+                g_latencyMax = l_latency;
+            }
+        }
+    }
+    return l_count;
+}
+
+/*******************************************************************************
+ *                         avr-libc conversions                                *
+ *******************************************************************************/
+
+char *ultoa(unsigned long a_value, char *a_str, int a_radix) {
+    char l_digits[33];
+    uint8 l_count = 0;
+    uint8 i = 0;
+
+    do {
+        l_digits[l_count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[a_value % (unsigned long) a_radix];
+        a_value /= (unsigned long) a_radix;
+    } while (a_value != 0);
+    while (l_count > 0) {
+        a_str[i++] = l_digits[--l_count];
+    }
+    a_str[i] = '\0';
+    return a_str;
+}
+
+char *utoa(unsigned int a_value, char *a_str, int a_radix) {
+    return ultoa(a_value, a_str, a_radix);
+}
+
+char *itoa(int a_value, char *a_str, int a_radix) {
+    if ((a_value < 0) && (a_radix == 10)) {
+        a_str[0] = '-';
+        ultoa((unsigned long) -(long) a_value, a_str + 1, a_radix);
+        return a_str;
+    }
+    return ultoa((unsigned int) a_value, a_str, a_radix);
+}
+
+/*******************************************************************************
+ *                                 Trace                                       *
+ *******************************************************************************/
+
+/* Loads one echo width in ULTRASONIC_ICU_CLOCK ticks per line, 0 for no echo or "lost" for a sensor
+ * that does not answer, '#' starts a comment */
+static boolean Sim_loadTrace(const char *a_path) {
+    FILE *l_file = fopen(a_path, "r");
+    char l_line[128];
+    char *l_end;
+    unsigned long l_ticks;
+
+    if (l_file == NULL) {
+        perror(a_path);
+        return FALSE;
+    }
+    while (fgets(l_line, sizeof(l_line), l_file) != NULL) {
+        l_end = strchr(l_line, '#');
+        if (l_end != NULL) {
+            *l_end = '\0';
+        }
+        l_end = l_line + strspn(l_line, " \t");
+        if (strncmp(l_end, "lost", 4) == 0) {
+            Sim_addSample(SIM_TICKS_LOST);
+            continue;
+        }
+        l_ticks = strtoul(l_line, &l_end, 10);
+        if (l_end == l_line) {
+            continue;  /**< Blank or comment line */
+        }
+        Sim_addSample((uint16) ((l_ticks >= SIM_TICKS_LOST) ? 0 : l_ticks));
+    }
+    fclose(l_file);
+    return g_sampleCount != 0;
+}
+
+int main(int argc, char **argv) {
+    const char *l_trace = NULL;
+    const char *l_profile = NULL;
+    uint32 l_episodes = 50;
+    uint32 l_seed = 1;
+    uint32 l_budget = SIM_ALERT_BUDGET_MS;
+    uint64_t l_maxTime = SIM_NO_EVENT;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            g_quiet = TRUE;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            g_checkStartup = TRUE;
+        } else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) {
+            g_uartOut = fopen(argv[++i], "wb");
+            if (g_uartOut == NULL) {
+                perror(argv[i]);
+                return 1;
+            }
+        } else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc)) {
+            l_maxTime = strtoull(argv[++i], NULL, 10) * SIM_CYCLES_PER_MS;
+        } else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc)) {
+            l_profile = argv[++i];
+        } else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+            l_episodes = strtoul(argv[++i], NULL, 10);
+        } else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+            l_seed = strtoul(argv[++i], NULL, 10);
+        } else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc)) {
+            l_budget = strtoul(argv[++i], NULL, 10);
+        } else {
+            l_trace = argv[i];
+        }
+    }
+    if (l_profile != NULL) {
+        g_bench = TRUE;
+        g_endAt = (l_episodes == 0) ? 0 : SimBench_setup(l_profile, l_episodes, l_seed, l_budget);
+    }
+    if (g_bench ? (g_endAt == 0) : ((l_trace == NULL) || !Sim_loadTrace(l_trace))) {
+        fprintf(stderr, "usage: %s [-q] [-c] [-o telemetry.bin] [-t max_ms] trace\n"
+                "       %s [-q] [-o telemetry.bin] [-t max_ms] -b step|ramp[:mm/s] [-n crossings] [-s seed] [-l budget_ms]\n",
+                argv[0], argv[0]);
+        return 1;
+    }
+    if (l_maxTime < g_endAt) {
+        g_endAt = l_maxTime;
+    }
+
+    /* Out of reset the global interrupt flag is cleared */
+    SREG = 0;
+    return App_main();
+}
@@ -0,0 +1,413 @@
+/**
+ * @file sim_mcal.c
+ * @brief Models of the Timer0, Timer2, ICU, EEPROM, ADC and watchdog drivers for the host simulation build.
+ *
+ * Each model implements the header of the driver it replaces on the simulated clock: compare
+ * matches and overflows become events at their exact cycle, and the interrupt handlers call the
+ * registered callbacks the same way the target ISRs do. A watchdog timeout ends the run with an
+ * error instead of resetting the MCU.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "../mcal/timer0.h"
+#include "../mcal/timer2.h"
+#include "../mcal/icu.h"
+#include "../mcal/eeprom.h"
+#include "../mcal/adc.h"
+#include "../mcal/wdt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** @brief Value of a model event time when the event is not scheduled. */
+#define SIM_NO_EVENT UINT64_MAX
+
+/*******************************************************************************
+ *                                  Timer0                                     *
+ *******************************************************************************/
+
+static void (*g_timer0CallBack[TIMER0_MAX_CALLBACKS])(void);
+static uint8 g_timer0CallBackCount = 0;
+static uint32 g_timer0Ticks = 0;
+static uint32 g_timer0Prescaler = 0;       /**< 0 while the timer is stopped */
+static uint16 g_timer0ClocksPerTick = 256;
+static uint64_t g_timer0LastMatch = 0;     /**< Cycle of the last compare match, TCNT0 restarted from 0 */
+static uint64_t g_timer0NextMatch = SIM_NO_EVENT;
+static boolean g_timer0Pending = FALSE;    /**< OCF0: match not served by the ISR yet */
+
+void Timer0_init(const Timer0_ConfigType *Config_Ptr) {
+    static const uint16 l_prescalers[] = { 0, 1, 8, 64, 256, 1024 };
+
+    g_timer0Prescaler = l_prescalers[Config_Ptr->clock];
+    g_timer0ClocksPerTick = (uint16) Config_Ptr->compareValue + 1;
+    g_timer0LastMatch = Sim_now();
+    g_timer0NextMatch = (g_timer0Prescaler == 0) ? SIM_NO_EVENT
+            : g_timer0LastMatch + (uint64_t) g_timer0ClocksPerTick * g_timer0Prescaler;
+}
+
+boolean Timer0_addCallBack(void (*a_ptr)(void)) {
+    if (g_timer0CallBackCount >= TIMER0_MAX_CALLBACKS) {
+        return FALSE;
+    }
+    g_timer0CallBack[g_timer0CallBackCount++] = a_ptr;
+    return TRUE;
+}
+
+uint32 Timer0_getTicks(void) {
+    return g_timer0Ticks;
+}
+
+uint32 Timer0_getTimestamp(void) {
+    uint32 l_ticks;
+    uint32 l_count;
+
+    /* Charge the poll, a loop waiting on the timestamp would never end otherwise */
+    Sim_delayCycles(SIM_POLL_CYCLES);
+
+    l_ticks = g_timer0Ticks + (g_timer0Pending ? 1 : 0);
+    l_count = (g_timer0Prescaler == 0) ? 0 : (uint32) ((Sim_now() - g_timer0LastMatch) / g_timer0Prescaler);
+    return l_ticks * g_timer0ClocksPerTick + l_count;
+}
+
+void Timer0_deInit(void) {
+    g_timer0Prescaler = 0;
+    g_timer0NextMatch = SIM_NO_EVENT;
+    g_timer0CallBackCount = 0;
+}
+
+/*******************************************************************************
+ *                                  Timer2                                     *
+ *******************************************************************************/
+
+static void (*g_timer2CallBack)(void) = NULL_PTR;
+static uint32 g_timer2Prescaler = 0;
+static uint8 g_timer2Compare = 0;
+static uint64_t g_timer2NextMatch = SIM_NO_EVENT;
+
+void Timer2_init(const Timer2_ConfigType *Config_Ptr) {
+    static const uint16 l_prescalers[] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+    g_timer2Prescaler = l_prescalers[Config_Ptr->clock];
+    g_timer2Compare = Config_Ptr->compareValue;
+    g_timer2NextMatch = (g_timer2Prescaler == 0) ? SIM_NO_EVENT
+            : Sim_now() + ((uint64_t) g_timer2Compare + 1) * g_timer2Prescaler;
+}
+
+void Timer2_setCallBack(void (*a_ptr)(void)) {
+    g_timer2CallBack = a_ptr;
+}
+
+void Timer2_setCompareValue(uint8 a_compareValue) {
+    g_timer2Compare = a_compareValue;
+}
+
+void Timer2_deInit(void) {
+    g_timer2Prescaler = 0;
+    g_timer2NextMatch = SIM_NO_EVENT;
+}
+
+/*******************************************************************************
+ *                              ICU (Timer1)                                   *
+ *******************************************************************************/
+
+static void (*g_icuCallBack)(void) = NULL_PTR;
+static void (*g_icuOverflowCallBack)(void) = NULL_PTR;
+static uint32 g_icuPrescaler = 0;
+static ICU_EdgeType g_icuEdge = RAISING;
+static boolean g_icuCaptureOn = FALSE;
+static boolean g_icuOverflowOn = FALSE;    /**< Overflow callback enabled, the interrupt itself always runs */
+static uint64_t g_icuBase = 0;             /**< Cycle at which the 32-bit timestamp was 0 */
+static uint32 g_icuCapture = 0;            /**< 32-bit timestamp of the last capture, ICR1 is its low word */
+static uint64_t g_icuNextOverflow = SIM_NO_EVENT;
+
+/* 32-bit timestamp at the current cycle, TCNT1 is its low word */
+static uint32 SimMcal_tcnt1(void) {
+    return (g_icuPrescaler == 0) ? 0 : (uint32) ((Sim_now() - g_icuBase) / g_icuPrescaler);
+}
+
+static void SimMcal_scheduleOverflow(void) {
+    uint64_t l_period = 65536ULL * g_icuPrescaler;
+
+    g_icuNextOverflow = (g_icuPrescaler == 0) ? SIM_NO_EVENT
+            : g_icuBase + ((Sim_now() - g_icuBase) / l_period + 1) * l_period;
+}
+
+void ICU_init(const ICU_ConfigType *Config_Ptr) {
+    g_icuPrescaler = ICU_PRESCALER_VALUE(Config_Ptr->clock);
+    g_icuEdge = Config_Ptr->edge;
+    g_icuBase = Sim_now();
+    g_icuCapture = 0;
+    g_icuCaptureOn = TRUE;
+    SimMcal_scheduleOverflow();
+}
+
+#ifdef ICU_DIRECT_CAPTURE_MODE
+/* Overflow count read by ICU_extendCapture, the capture vector is defined by the ultrasonic driver */
+volatile uint16 g_icuTimerHigh = 0;
+void TIMER1_CAPT_vect(void);
+#endif
+
+void ICU_setCallBack(void (*a_ptr)(void)) {
+    g_icuCallBack = a_ptr;
+}
+
+void ICU_setEdgeDetectionType(const ICU_EdgeType a_edgeType) {
+    g_icuEdge = a_edgeType;
+}
+
+uint16 ICU_getInputCaptureValue(void) {
+    return (uint16) g_icuCapture;
+}
+
+uint32 ICU_getCaptureTimestamp(void) {
+    return g_icuCapture;
+}
+
+uint32 ICU_getTimestamp(void) {
+    return SimMcal_tcnt1();
+}
+
+void ICU_clearTimerValue(void) {
+    g_icuBase = Sim_now();
+    SimMcal_scheduleOverflow();
+}
+
+void ICU_deInit(void) {
+    g_icuPrescaler = 0;
+    g_icuCaptureOn = FALSE;
+    g_icuOverflowOn = FALSE;
+    g_icuNextOverflow = SIM_NO_EVENT;
+    g_icuCallBack = NULL_PTR;
+    g_icuOverflowCallBack = NULL_PTR;
+}
+
+void ICU_interruptOn() {
+    g_icuCaptureOn = TRUE;
+}
+
+void ICU_interruptOff() {
+    g_icuCaptureOn = FALSE;
+}
+
+void ICU_setOverflowCallBack(void (*a_ptr)(void)) {
+    g_icuOverflowCallBack = a_ptr;
+}
+
+void ICU_overflowInterruptOn(void) {
+    g_icuOverflowOn = TRUE;
+}
+
+void ICU_overflowInterruptOff(void) {
+    g_icuOverflowOn = FALSE;
+}
+
+/*******************************************************************************
+ *                                 Watchdog                                    *
+ *******************************************************************************/
+
+/** @brief Watchdog oscillator cycles of the shortest timeout, 16K cycles of the 1 MHz oscillator. */
+#define SIM_WDT_BASE_US 16384ULL
+
+static uint64_t g_wdtTimeout = 0;               /**< Timeout in CPU cycles, 0 while stopped */
+static uint64_t g_wdtExpiry = SIM_NO_EVENT;
+
+void WDT_enable(WDT_TimeoutType a_timeout) {
+    g_wdtTimeout = (SIM_WDT_BASE_US << (a_timeout & 0x07)) * (F_CPU / 1000000UL);
+    WDT_reset();
+}
+
+void WDT_reset(void) {
+    if (g_wdtTimeout != 0) {
+        g_wdtExpiry = Sim_now() + g_wdtTimeout;
+    }
+}
+
+void WDT_disable(void) {
+    g_wdtTimeout = 0;
+    g_wdtExpiry = SIM_NO_EVENT;
+}
+
+/* The simulated MCU always starts from a power-on reset */
+boolean WDT_causedReset(void) {
+    return FALSE;
+}
+
+/*******************************************************************************
+ *                             Model interface                                 *
+ *******************************************************************************/
+
+/**
+ * @brief Returns the cycle of the next timer event, SIM_NO_EVENT if none is scheduled.
+ */
+uint64_t SimMcal_nextEvent(void) {
+    uint64_t l_next = g_timer0NextMatch;
+
+    if (g_timer2NextMatch < l_next) {
+        l_next = g_timer2NextMatch;
+    }
+    if (g_icuNextOverflow < l_next) {
+        l_next = g_icuNextOverflow;
+    }
+    if (g_wdtExpiry < l_next) {
+        l_next = g_wdtExpiry;
+    }
+    return l_next;
+}
+
+/**
+ * @brief Raises the interrupts of the timer events due at the current cycle.
+ *
+ * @param a_now The current cycle.
+ */
+void SimMcal_process(uint64_t a_now) {
+    if (g_timer0NextMatch <= a_now) {
+        g_timer0LastMatch = g_timer0NextMatch;
+        g_timer0NextMatch += (uint64_t) g_timer0ClocksPerTick * g_timer0Prescaler;
+        g_timer0Pending = TRUE;
+        Sim_raise(SIM_IRQ_TIMER0_COMP);
+    }
+    if (g_timer2NextMatch <= a_now) {
+        /* OCR2 is read at the match, the callback may change it for the period just started */
+        g_timer2NextMatch = SIM_NO_EVENT;
+        Sim_raise(SIM_IRQ_TIMER2_COMP);
+    }
+    if (g_icuNextOverflow <= a_now) {
+        g_icuNextOverflow += 65536ULL * g_icuPrescaler;
+        Sim_raise(SIM_IRQ_TIMER1_OVF);
+    }
+    if (g_wdtExpiry <= a_now) {
+        fprintf(stderr, "sim: watchdog reset at %.1f ms, the main loop was not kicked for %.1f ms\n",
+                (double) a_now / (F_CPU / 1000UL), (double) g_wdtTimeout / (F_CPU / 1000UL));
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Runs the interrupt handler of a timer interrupt, called with interrupts disabled.
+ *
+ * @param a_irq The interrupt.
+ */
+void SimMcal_serve(Sim_IrqType a_irq) {
+    uint8 i;
+    uint64_t l_match;
+
+    switch (a_irq) {
+    case SIM_IRQ_TIMER0_COMP:
+        g_timer0Pending = FALSE;
+        g_timer0Ticks++;
+        for (i = 0; i < g_timer0CallBackCount; i++) {
+            (*g_timer0CallBack[i])();
+        }
+        break;
+    case SIM_IRQ_TIMER2_COMP:
+        l_match = Sim_now();
+        if (g_timer2CallBack != NULL_PTR) {
+            (*g_timer2CallBack)();
+        }
+        if (g_timer2Prescaler != 0) {
+            g_timer2NextMatch = l_match + ((uint64_t) g_timer2Compare + 1) * g_timer2Prescaler;
+        }
+        break;
+    case SIM_IRQ_TIMER1_CAPT:
+#ifdef ICU_DIRECT_CAPTURE_MODE
+        TIMER1_CAPT_vect();
+#else
+        if (g_icuCallBack != NULL_PTR) {
+            (*g_icuCallBack)();
+        }
+#endif
+        break;
+    case SIM_IRQ_TIMER1_OVF:
+        if (g_icuOverflowOn && (g_icuOverflowCallBack != NULL_PTR)) {
+            (*g_icuOverflowCallBack)();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Applies an edge of the echo signal on ICP1.
+ *
+ * @param a_rising TRUE for a rising edge.
+ */
+void SimMcal_echoEdge(uint8_t a_rising) {
+    if (!g_icuCaptureOn || (g_icuPrescaler == 0) || ((g_icuEdge == RAISING) != (a_rising != 0))) {
+        return;  /**< Edges while the interrupt is off are discarded by ICU_interruptOn() anyway */
+    }
+    g_icuCapture = SimMcal_tcnt1();
+#ifdef ICU_DIRECT_CAPTURE_MODE
+    /* The modeled overflows are never pending at a capture, TIFR stays clear */
+    ICR1_REG.word = (uint16) g_icuCapture;
+    g_icuTimerHigh = (uint16) (g_icuCapture >> 16);
+#endif
+    Sim_raise(SIM_IRQ_TIMER1_CAPT);
+}
+
+/*******************************************************************************
+ *                              EEPROM and ADC                                 *
+ *******************************************************************************/
+
+static uint8 g_eeprom[EEPROM_SIZE];
+static boolean g_eepromLoaded = FALSE;          /**< Erased on first use, like a new part */
+static uint64_t g_eepromReadyAt = 0;            /**< Cycle at which the byte write in progress completes */
+
+/* A byte write takes 8.5 ms in the background, the blocking accesses take no simulated time */
+#define SIM_EEPROM_WRITE_CYCLES (F_CPU / 2000UL * 17UL)
+
+static uint8 *SimMcal_eeprom(uint16 a_address) {
+    uint16 i;
+
+    if (!g_eepromLoaded) {
+        for (i = 0; i < EEPROM_SIZE; i++) {
+            g_eeprom[i] = EEPROM_ERASED_BYTE;
+        }
+        g_eepromLoaded = TRUE;
+    }
+    return &g_eeprom[a_address % EEPROM_SIZE];
+}
+
+uint8 EEPROM_readByte(uint16 a_address) {
+    return *SimMcal_eeprom(a_address);
+}
+
+void EEPROM_writeByte(uint16 a_address, uint8 a_data) {
+    *SimMcal_eeprom(a_address) = a_data;
+    g_eepromReadyAt = Sim_now() + SIM_EEPROM_WRITE_CYCLES;
+}
+
+boolean EEPROM_isReady(void) {
+    return Sim_now() >= g_eepromReadyAt;
+}
+
+void EEPROM_readBlock(uint16 a_address, uint8 *a_data, uint16 a_size) {
+    uint16 i;
+
+    for (i = 0; i < a_size; i++) {
+        a_data[i] = EEPROM_readByte(a_address + i);
+    }
+}
+
+void EEPROM_updateBlock(uint16 a_address, const uint8 *a_data, uint16 a_size) {
+    uint16 i;
+
+    for (i = 0; i < a_size; i++) {
+        EEPROM_writeByte(a_address + i, a_data[i]);
+    }
+}
+
+/* Every channel reads mid-scale, conversions take no simulated time */
+void ADC_init(const ADC_ConfigType *Config_Ptr) {
+    (void) Config_Ptr;
+}
+
+uint16 ADC_readChannel(uint8 a_channel) {
+    (void) a_channel;
+    return (ADC_MAXIMUM_VALUE + 1) / 2;
+}
+
+void ADC_deInit(void) {
+}
@@ -0,0 +1,71 @@
+/**
+ * @file sim_port.h
+ * @brief Port layer of the host simulation build, included before every source file.
+ *
+ * The application, HAL and services are compiled unchanged. The timing drivers (Timer0, Timer2
+ * and the ICU on Timer1) are replaced by models running on a simulated CPU clock, and the register
+ * drivers (GPIO, UART) run as-is on the simulated I/O space. Code runs in zero simulated time,
+ * the clock only moves in busy waits, timestamp polls and sleep.
+ *
+ * @date 14 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_PORT_H_
+#define SIM_PORT_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Simulated cycles charged to every timestamp read, so that polling loops make progress.
+ */
+#define SIM_POLL_CYCLES 16
+
+/*******************************************************************************
+ *                               Data Types                                    *
+ *******************************************************************************/
+
+/**
+ * @enum Sim_IrqType
+ * @brief Interrupt sources of the model, in the priority order of the ATmega32 vector table.
+ */
+typedef enum {
+    SIM_IRQ_TIMER2_COMP,
+    SIM_IRQ_TIMER1_CAPT,
+    SIM_IRQ_TIMER1_OVF,
+    SIM_IRQ_TIMER0_COMP,
+    SIM_IRQ_USART_UDRE,
+    SIM_IRQ_COUNT
+} Sim_IrqType;
+
+/*******************************************************************************
+ *                               Function Prototypes                           *
+ *******************************************************************************/
+
+/* Simulated clock and interrupts (sim_core.c) */
+uint64_t Sim_now(void);
+void Sim_delayCycles(uint64_t a_cycles);
+void Sim_raise(Sim_IrqType a_irq);
+
+/* Timing driver models (sim_mcal.c) */
+uint64_t SimMcal_nextEvent(void);
+void SimMcal_process(uint64_t a_now);
+void SimMcal_serve(Sim_IrqType a_irq);
+void SimMcal_echoEdge(uint8_t a_rising);
+
+/* Alert latency benchmark (sim_bench.c) */
+uint64_t SimBench_setup(const char *a_spec, uint32_t a_episodes, uint32_t a_seed, uint32_t a_budgetMs);
+uint16_t SimBench_echoTicks(uint64_t a_now, uint32_t a_icuPrescaler);
+void SimBench_watch(uint64_t a_now);
+int SimBench_report(uint64_t a_now, uint32_t a_pinged);
+
+/* avr-libc conversions missing from the host C library (sim_core.c) */
+char *itoa(int a_value, char *a_str, int a_radix);
+char *utoa(unsigned int a_value, char *a_str, int a_radix);
+char *ultoa(unsigned long a_value, char *a_str, int a_radix);
+
+#endif /* SIM_PORT_H_ */